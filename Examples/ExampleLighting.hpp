@@ -117,7 +117,7 @@ namespace CForge {
 			m_RenderDev.addLight(&m_Flashlight);
 			updateSun();
 
-			m_LastPointLightUpdate = CForgeUtility::timestamp();
+			m_LastPointLightUpdate = m_pFrameClock->time();
 
 			m_IsSunActive = true;
 
@@ -152,7 +152,7 @@ namespace CForge {
 			m_SkyboxSG.update(60.0f / m_FPS);
 
 			// sun simulation
-			float Azimuth = (CForgeUtility::timestamp() % 10000000) / 1000.0f;
+			float Azimuth = std::fmod(m_pFrameClock->seconds(), 10000.0f);
 			Azimuth *= 0.2f;
 			m_SunAzimuth = Azimuth - std::floor(Azimuth / (2.0f * EIGEN_PI)) * (2.0f * EIGEN_PI);
 			updateSun();
@@ -164,9 +164,9 @@ namespace CForge {
 				m_Flashlight.direction(m_Cam.dir());
 			}
 
-			if (CForgeUtility::timestamp() - m_LastPointLightUpdate > 200) {
+			if (m_pFrameClock->time() - m_LastPointLightUpdate > 200000) {
 				updatePointLights();
-				m_LastPointLightUpdate = CForgeUtility::timestamp();
+				m_LastPointLightUpdate = m_pFrameClock->time();
 			}
 			
 			m_RenderDev.activePass(RenderDevice::RENDERPASS_SHADOW, &m_Sun);
@@ -334,7 +334,7 @@ namespace CForge {
 		void updatePointLights(void) {
 			if (m_PointLights[PL_MANAWELL_1]->PL.intensity() < 0.1f) return; // mana wells are turend off
 
-			float Value = CForgeUtility::timestamp() % 1000000 / 1000.0f;
+			float Value = std::fmod(m_pFrameClock->seconds(), 1000.0f);
 			Value = std::sin(Value*2.0f);
 			m_PointLights[PL_MANAWELL_1]->PL.intensity(50 + (Value * 35.0f));
 			m_PointLights[PL_MANAWELL_2]->PL.intensity(50 + (Value * 35.0f));
@@ -363,7 +363,7 @@ namespace CForge {
 
 		std::vector<PointLightStruct*> m_PointLights;
 
-		uint32_t m_LastPointLightUpdate;
+		uint64_t m_LastPointLightUpdate; ///< Frame time in microseconds
 
 		bool m_IsSunActive;
 		bool m_IsFlashlightActive;
@@ -161,7 +161,7 @@ namespace CForge {
 			if (nullptr == pBaseMesh) throw NullpointerExcept("pBaseMesh");
 
 			printf("Building morph target model...");
-			uint64_t Start = CForgeUtility::timestamp();
+			uint64_t Start = SFrameClock::now();
 
 			// create morph target build and initialize with base mesh
 			MorphTargetModelBuilder MTBuilder;
@@ -198,7 +198,7 @@ namespace CForge {
 			MTBuilder.build();
 			MTBuilder.retrieveMorphTargets(pBaseMesh);
 
-			printf(" finished in %d ms\n", uint32_t(CForgeUtility::timestamp() - Start));
+			printf(" finished in %d ms\n", uint32_t((SFrameClock::now() - Start) / 1000));
 		}//buildMTModel
 
 		void buildMTSequences(MorphTargetAnimationController* pController) {
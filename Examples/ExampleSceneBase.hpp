@@ -20,6 +20,7 @@
 
 #include <crossforge/Math/CForgeMath.h>
 #include <crossforge/Utility/CForgeUtility.h>
+#include <crossforge/Core/SFrameClock.h>
 #include <crossforge/AssetIO/SAssetIO.h>
 #include <crossforge/Graphics/Shader/SShaderManager.h>
 #include <crossforge/Graphics/STextureManager.h>
@@ -62,7 +63,8 @@ namespace CForge {
 			m_ScreenshotExtension = "webp";
 			m_FPS = 60.0f;
 			m_FPSCount = 0;
-			m_LastFPSPrint = CForgeUtility::timestamp();
+			m_LastFPSPrint = 0;
+			m_pFrameClock = nullptr;
 			m_CameraRotation = false;
 			m_FPSLabelActive = false;
 		}//Constructor
@@ -85,6 +87,8 @@ namespace CForge {
 			m_RenderWin.stopListening(this);
 			if (nullptr != m_pShaderMan) m_pShaderMan->release();
 			m_pShaderMan = nullptr;
+			if (nullptr != m_pFrameClock) m_pFrameClock->release();
+			m_pFrameClock = nullptr;
 		}//clear
 
 		virtual void release(void) {
@@ -141,6 +145,9 @@ namespace CForge {
 			m_RenderWin.init(Vector2i(100, 100), Vector2i(m_WinWidth, m_WinHeight), m_WindowTitle);
 			m_RenderWin.startListening(this);
 
+			if (nullptr == m_pFrameClock) m_pFrameClock = SFrameClock::instance();
+			m_LastFPSPrint = m_pFrameClock->realTime();
+
 			auto Traits = CForgeUtility::retrieveGPUTraits();
 			SLogger::log("Created context with GL version: " + Traits.GLVersion + "\n", "ProgramFlow");
 
@@ -230,9 +237,13 @@ namespace CForge {
 			const uint32_t UpdateInterval = 250; // update of FPS 4 times per second
 			m_FPSCount++;
 
-			if (CForgeUtility::timestamp() - m_LastFPSPrint >= UpdateInterval) {
+			// sample the frame clock once per frame, controllers and actors use this time
+			m_pFrameClock->tick();
+			const uint64_t Elapsed = m_pFrameClock->realTime() - m_LastFPSPrint;
+
+			if (Elapsed >= UpdateInterval * 1000) {
 				char Buf[64];
-				m_FPS = float(m_FPSCount * 1000.0f / (CForgeUtility::timestamp() - m_LastFPSPrint));
+				m_FPS = float(m_FPSCount * 1000000.0 / Elapsed);
 				m_FPS = std::max(m_FPS, 1.0f);
 				sprintf(Buf, "FPS: %.1f", m_FPS);		
 				
@@ -240,7 +251,7 @@ namespace CForge {
 				if (m_FPSLabelActive) m_FPSLabel.text(std::string(Buf));
 
 				m_FPSCount = 0;
-				m_LastFPSPrint = CForgeUtility::timestamp();
+				m_LastFPSPrint = m_pFrameClock->realTime();
 
 				std::string ErrorMsg;
 				if (GL_NO_ERROR != CForgeUtility::checkGLError(&ErrorMsg)) {
@@ -375,6 +386,7 @@ namespace CForge {
 		int32_t m_RenderBufferScale;
 
 		SShaderManager* m_pShaderMan;
+		SFrameClock* m_pFrameClock;
 
 		GLWindow m_RenderWin;
 		RenderDevice m_RenderDev;
@@ -384,7 +396,7 @@ namespace CForge {
 
 		// Performance monitoring
 		float m_FPS;
-		uint64_t m_LastFPSPrint;
+		uint64_t m_LastFPSPrint; ///< Real time of the frame clock in microseconds
 		uint32_t m_FPSCount;
 
 		DirectionalLight m_Sun;
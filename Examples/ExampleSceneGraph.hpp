@@ -37,6 +37,9 @@ namespace CForge {
 			initWindowAndRenderDevice();
 			initCameraAndLights();
 
+			// sort draw requests and merge the trees into instanced draw calls
+			m_RenderDev.enableRenderQueue(true);
+
 			initSkybox();
 			initFPSLabel();
 			m_FPSLabel.color(1.0f, 1.0f, 1.0f, 1.0f);
@@ -20,6 +20,7 @@
 
 #include <crossforge/Graphics/Actors/SkeletalActor.h>
 #include <crossforge/Graphics/Actors/StickFigureActor.h>
+#include <crossforge/Graphics/Controller/SkeletalAnimationSystem.h>
 
 #include "ExampleSceneBase.hpp"
 
@@ -65,6 +66,11 @@ namespace CForge {
 			m_CesiumManStick.init(&M, &m_BipedController);
 			M.clear();
 
+			// poses of all registered actors get evaluated in parallel before rendering
+			m_AnimationSystem.init();
+			m_AnimationSystem.addActor(&m_CesiumMan);
+			m_AnimationSystem.addActor(&m_CesiumManStick);
+
 			// add skeletal actor to scene graph (Eric)			
 			m_CesiumManTransformSGN.init(&m_RootSGN, Vector3f(0.0f, -0.025f, 0.0f));
 			m_CesiumManOffsetSGN.init(&m_CesiumManTransformSGN, Vector3f(0.0f, 0.0f, -8.0f));
@@ -98,6 +104,7 @@ namespace CForge {
 		}//initialize
 
 		void clear(void) override{
+			m_AnimationSystem.clear();
 			ExampleSceneBase::clear();
 		}
 
@@ -147,6 +154,8 @@ namespace CForge {
 				m_RepeatAnimation = !m_RepeatAnimation;
 			}
 
+			m_AnimationSystem.update();
+
 			m_RenderDev.activePass(RenderDevice::RENDERPASS_SHADOW, &m_Sun);
 			m_RenderDev.activeCamera(const_cast<VirtualCamera*>(m_Sun.camera()));
 			m_SG.render(&m_RenderDev);
@@ -174,6 +183,7 @@ namespace CForge {
 		SkeletalActor m_CesiumMan;
 		StickFigureActor m_CesiumManStick;
 		SkeletalAnimationController m_BipedController;	
+		SkeletalAnimationSystem m_AnimationSystem;
 		SGNGeometry m_CesiumManSGN;
 		SGNGeometry m_CesiumManStickSGN;
 		SGNTransformation m_CesiumManTransformSGN;
@@ -0,0 +1,204 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): ExampleTransformHierarchy.hpp                                    *
+*                                                                           *
+* Content: Example scene that animates a large number of nested orbits     *
+*          with the flat TransformHierarchy and renders them instanced.     *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_EXAMPLETRANSFORMHIERARCHY_HPP__
+#define __CFORGE_EXAMPLETRANSFORMHIERARCHY_HPP__
+
+#include <crossforge/MeshProcessing/PrimitiveShapeFactory.h>
+#include <crossforge/Graphics/SceneGraph/TransformHierarchy.h>
+#include "ExampleSceneBase.hpp"
+
+namespace CForge {
+
+	/**
+	* \brief Suns with planets with moons. Every orbit is a node of a TransformHierarchy, one update per frame computes all world transformations and each kind of body is drawn with a single instanced actor.
+	*/
+	class ExampleTransformHierarchy : public ExampleSceneBase {
+	public:
+		ExampleTransformHierarchy(void) {
+			m_WindowTitle = "CrossForge Example - Transform Hierarchy";
+		}//Constructor
+
+		~ExampleTransformHierarchy(void) {
+			clear();
+		}//Destructor
+
+		void init(void) override {
+			initWindowAndRenderDevice();
+			initCameraAndLights();
+			m_Cam.lookAt(Vector3f(0.0f, 120.0f, 200.0f), Vector3f(0.0f, 15.0f, 0.0f));
+			m_Sun.initShadowCasting(2048 * 2, 2048 * 2, Vector2i(300, 300), 1.0f, 5000.0f);
+			initSkybox();
+			initFPSLabel();
+			m_FPSLabel.color(1.0f, 1.0f, 1.0f, 1.0f);
+
+			m_RootSGN.init(nullptr);
+			m_SG.init(&m_RootSGN);
+
+			// one sphere actor per kind of body, the hierarchy provides the instances
+			T3DMesh<float> M;
+			PrimitiveShapeFactory::uvSphere(&M, Vector3f(1.0f, 1.0f, 1.0f), 16, 16);
+			M.computePerVertexNormals();
+			const CForgeUtility::DefaultMaterial Materials[BODY_COUNT] = { CForgeUtility::METAL_GOLD, CForgeUtility::PLASTIC_BLUE, CForgeUtility::PLASTIC_GREY };
+			for (uint32_t i = 0; i < BODY_COUNT; ++i) {
+				CForgeUtility::defaultMaterial(M.getMaterial(0), Materials[i]);
+				m_Bodies[i].init(&M);
+				// instances spread over the whole scene, so the sphere's bounding volume does not apply
+				m_Bodies[i].boundingVolume(BoundingVolume());
+				m_BodySGNs[i].init(&m_RootSGN, &m_Bodies[i]);
+			}
+			M.clear();
+
+			m_Hierarchy.init();
+			const int32_t GridSize = 4;
+			const float SunDistance = 60.0f;
+			for (int32_t z = 0; z < GridSize; ++z) {
+				for (int32_t x = 0; x < GridSize; ++x) {
+					const Vector3f SunPos = Vector3f((x - (GridSize - 1) * 0.5f) * SunDistance, 15.0f, (z - (GridSize - 1) * 0.5f) * SunDistance);
+					const TransformHierarchy::Handle Sun = m_Hierarchy.create(TransformHierarchy::Handle(), SunPos);
+					m_Suns.push_back(Sun);
+					createBody(Sun, BODY_SUN, Vector3f::Zero(), 3.0f);
+
+					for (uint32_t p = 0; p < 6; ++p) {
+						// pivot rotates, the anchor carries the planet along its orbit
+						const TransformHierarchy::Handle Pivot = createOrbit(Sun, CForgeMath::randRange(0.2f, 1.0f));
+						m_PlanetPivots.push_back(Pivot);
+						const TransformHierarchy::Handle Anchor = m_Hierarchy.create(Pivot, Vector3f(6.0f + p * 3.5f, 0.0f, 0.0f));
+						createBody(Anchor, BODY_PLANET, Vector3f::Zero(), CForgeMath::randRange(0.5f, 1.2f));
+
+						for (uint32_t m = 0; m < 3; ++m) {
+							const TransformHierarchy::Handle MoonPivot = createOrbit(Anchor, CForgeMath::randRange(1.0f, 3.0f));
+							createBody(MoonPivot, BODY_MOON, Vector3f(1.6f + m * 0.5f, 0.0f, 0.0f), 0.2f);
+						}//for[moons]
+					}//for[planets]
+				}//for[columns]
+			}//for[rows]
+
+			// create help text
+			LineOfText* pKeybindings = new LineOfText();
+			pKeybindings->init(CForgeUtility::defaultFont(CForgeUtility::FONTTYPE_SANSERIF, 18), "Movement: (Shift) + W,A,S,D  | Rotation: LMB/RMB + Mouse | R: Move a planet to another sun | F1: Toggle help text");
+			m_HelpTexts.push_back(pKeybindings);
+			m_DrawHelpTexts = true;
+
+			std::string ErrorMsg;
+			if (0 != CForgeUtility::checkGLError(&ErrorMsg)) {
+				SLogger::log("OpenGL Error" + ErrorMsg, "ExampleTransformHierarchy", SLogger::LOGTYPE_ERROR);
+			}
+		}//initialize
+
+		void clear(void) override {
+			m_Hierarchy.clear();
+			m_Orbits.clear();
+			for (auto& i : m_BodyHandles) i.clear();
+			m_Suns.clear();
+			m_PlanetPivots.clear();
+			ExampleSceneBase::clear();
+		}//clear
+
+		void mainLoop(void) override {
+			m_RenderWin.update();
+			defaultCameraUpdate(&m_Cam, m_RenderWin.keyboard(), m_RenderWin.mouse());
+
+			// structural change, the planet's whole subtree moves with it
+			if (m_RenderWin.keyboard()->keyPressed(Keyboard::KEY_R, true)) {
+				const TransformHierarchy::Handle Planet = m_PlanetPivots[CForgeMath::rand() % m_PlanetPivots.size()];
+				m_Hierarchy.parent(Planet, m_Suns[CForgeMath::rand() % m_Suns.size()]);
+			}
+
+			// only local transformations change, update propagates them in one sweep
+			const float TimeStep = 1.0f / std::max(m_FPS, 1.0f);
+			for (const auto& i : m_Orbits) {
+				const Quaternionf Step(AngleAxisf(i.Speed * TimeStep, Vector3f::UnitY()));
+				m_Hierarchy.rotation(i.Node, m_Hierarchy.rotation(i.Node) * Step);
+			}//for[orbits]
+			m_Hierarchy.update();
+
+			for (uint32_t i = 0; i < BODY_COUNT; ++i) {
+				m_Bodies[i].clearInstances();
+				for (const auto& k : m_BodyHandles[i]) {
+					Vector3f Translation;
+					Quaternionf Rotation;
+					Vector3f Scale;
+					m_Hierarchy.worldTransformation(k, &Translation, &Rotation, &Scale);
+					m_Bodies[i].addInstance(CForgeMath::modelMatrix(Rotation, Translation, Scale));
+				}//for[bodies]
+			}//for[kinds of bodies]
+
+			m_SkyboxSG.update(60.0f / m_FPS);
+			m_SG.update(60.0f / m_FPS);
+
+			m_RenderDev.activePass(RenderDevice::RENDERPASS_SHADOW, &m_Sun);
+			m_RenderDev.activeCamera(const_cast<VirtualCamera*>(m_Sun.camera()));
+			m_SG.render(&m_RenderDev);
+
+			m_RenderDev.activePass(RenderDevice::RENDERPASS_GEOMETRY);
+			m_RenderDev.activeCamera(&m_Cam);
+			m_SG.render(&m_RenderDev);
+
+			m_RenderDev.activePass(RenderDevice::RENDERPASS_LIGHTING);
+
+			m_RenderDev.activePass(RenderDevice::RENDERPASS_FORWARD, nullptr, false);
+			m_SkyboxSG.render(&m_RenderDev);
+			if (m_FPSLabelActive) m_FPSLabel.render(&m_RenderDev);
+			if (m_DrawHelpTexts) drawHelpTexts();
+
+			m_RenderWin.swapBuffers();
+
+			updateFPS();
+			defaultKeyboardUpdate(m_RenderWin.keyboard());
+		}//mainLoop
+
+	protected:
+		enum BodyType : uint8_t {
+			BODY_SUN = 0,
+			BODY_PLANET,
+			BODY_MOON,
+			BODY_COUNT,
+		};
+
+		struct Orbit {
+			TransformHierarchy::Handle Node;
+			float Speed; ///< Radians per second
+		};
+
+		TransformHierarchy::Handle createOrbit(TransformHierarchy::Handle Parent, float Speed) {
+			Orbit O;
+			O.Node = m_Hierarchy.create(Parent, Vector3f::Zero(), Quaternionf(AngleAxisf(CForgeMath::randRange(0.0f, 6.28f), Vector3f::UnitY())));
+			O.Speed = Speed;
+			m_Orbits.push_back(O);
+			return O.Node;
+		}//createOrbit
+
+		void createBody(TransformHierarchy::Handle Parent, BodyType Type, Vector3f Translation, float Scale) {
+			// scale stays on the leaves, so it does not propagate to orbiting children
+			m_BodyHandles[Type].push_back(m_Hierarchy.create(Parent, Translation, Quaternionf::Identity(), Vector3f(Scale, Scale, Scale)));
+		}//createBody
+
+		SGNTransformation m_RootSGN;
+		StaticActor m_Bodies[BODY_COUNT];
+		SGNGeometry m_BodySGNs[BODY_COUNT];
+
+		TransformHierarchy m_Hierarchy;
+		std::vector<Orbit> m_Orbits;
+		std::vector<TransformHierarchy::Handle> m_BodyHandles[BODY_COUNT];
+		std::vector<TransformHierarchy::Handle> m_Suns;
+		std::vector<TransformHierarchy::Handle> m_PlanetPivots;
+	};//ExampleTransformHierarchy
+
+}//name space
+
+#endif
@@ -77,11 +77,14 @@ void exportLibrary(void) {
 	IncludeFiles.push_back("Core/CForgeObject.h");
 	IncludeFiles.push_back("Core/CoreDefinitions.h");
 	IncludeFiles.push_back("Core/CrossForgeException.h");
+	IncludeFiles.push_back("Core/DoubleBuffer.hpp");
 	IncludeFiles.push_back("Core/ITCaller.hpp");
 	IncludeFiles.push_back("Core/ITListener.hpp");
 	IncludeFiles.push_back("Core/SCrossForgeDevice.h");
 	IncludeFiles.push_back("Core/SGPIO.h");
+	IncludeFiles.push_back("Core/SFrameClock.h");
 	IncludeFiles.push_back("Core/SLogger.h");
+	IncludeFiles.push_back("Core/SimulationThread.h");
 
 	// AssetIO include files.
 	Directories.push_back("crossforge/include/crossforge/AssetIO/");
@@ -146,6 +149,7 @@ void exportLibrary(void) {
 	IncludeFiles.push_back("Graphics/SceneGraph/SceneGraph.h");
 	IncludeFiles.push_back("Graphics/SceneGraph/SGNGeometry.h");
 	IncludeFiles.push_back("Graphics/SceneGraph/SGNTransformation.h");
+	IncludeFiles.push_back("Graphics/SceneGraph/TransformHierarchy.h");
 
 	// Graphics/Shader
 	Directories.push_back("crossforge/include/crossforge/Graphics/Shader/");
@@ -185,6 +189,7 @@ void exportLibrary(void) {
 	
 	// Mesh Processing
 	Directories.push_back("crossforge/include/crossforge/MeshProcessing/");
+	IncludeFiles.push_back("MeshProcessing/CPUMorphTargetBlending.h");
 	IncludeFiles.push_back("MeshProcessing/PrimitiveShapeFactory.h");
 
 	// Mesh Processing/Builder
@@ -23,6 +23,7 @@
 #include <Examples/ExampleShapesAndMaterials.hpp>
 #include <Examples/ExampleTextRendering.hpp>
 #include <Examples/ExampleLighting.hpp>
+#include <Examples/ExampleTransformHierarchy.hpp>
 
 using namespace CForge;
 using namespace Eigen;
@@ -35,6 +36,7 @@ using namespace Eigen;
 //#define ActiveScene ExampleShapesAndMaterials
 #define ActiveScene ExampleLighting
 //#define ActiveScene ExampleSceneGraph
+//#define ActiveScene ExampleTransformHierarchy
 //#define ActiveScene ExampleSkeletalAnimation
 //#define ActiveScene ExampleMorphTargetAnimation
 //#define ActiveScene ExampleMultiViewport
@@ -0,0 +1,75 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): DoubleBuffer.hpp                                                 *
+*                                                                           *
+* Content: State written by a simulation thread and read by the render     *
+*          thread.                                                          *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_DOUBLEBUFFER_HPP__
+#define __CFORGE_DOUBLEBUFFER_HPP__
+
+#include "CForgeObject.h"
+
+namespace CForge {
+
+	/**
+	* \brief Two copies of a state. The simulation works on one copy, rendering reads the other one. Publish copies the simulated state over and is called at the frame fence of SimulationThread, while the simulation is idle.
+	*
+	* Both copies keep their addresses, so the render copy can be handed to actors, e.g. an animation of SkeletalAnimationController that SkeletalActor plays.
+	*
+	* \todo Do full documentation.
+	*/
+	template<typename T>
+	class DoubleBuffer {
+	public:
+		DoubleBuffer(void) {
+
+		}//Constructor
+
+		DoubleBuffer(const T& Value) {
+			init(Value);
+		}//Constructor
+
+		~DoubleBuffer(void) {
+
+		}//Destructor
+
+		void init(const T& Value) {
+			m_Simulation = Value;
+			m_Render = Value;
+		}//initialize
+
+		T* simulation(void) {
+			return &m_Simulation;
+		}//simulation
+
+		T* render(void) {
+			return &m_Render;
+		}//render
+
+		const T* render(void)const {
+			return &m_Render;
+		}//render
+
+		void publish(void) {
+			m_Render = m_Simulation;
+		}//publish
+
+	protected:
+		T m_Simulation;
+		T m_Render;
+	};//DoubleBuffer
+
+}//name space
+
+#endif
@@ -0,0 +1,145 @@
+#include <chrono>
+#include <cmath>
+#include "SFrameClock.h"
+
+namespace CForge {
+
+	SFrameClock* SFrameClock::m_pInstance = nullptr;
+	int16_t SFrameClock::m_InstanceCount = 0;
+
+	SFrameClock* SFrameClock::instance(void) {
+		if (nullptr == m_pInstance) {
+			m_pInstance = new SFrameClock();
+			m_pInstance->init();
+		}
+		m_InstanceCount++;
+		return m_pInstance;
+	}//instance
+
+	void SFrameClock::release(void) {
+		if (0 == m_InstanceCount) throw CForgeExcept("Not enough instances for a release call!");
+		m_InstanceCount--;
+		if (0 == m_InstanceCount) {
+			delete m_pInstance;
+			m_pInstance = nullptr;
+		}
+	}//release
+
+	uint64_t SFrameClock::now(void) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}//now
+
+	SFrameClock::SFrameClock(void): CForgeObject("SFrameClock") {
+		m_Start = 0;
+		m_RealTime = 0;
+		m_RealDelta = 0;
+		m_Time = 0;
+		m_Delta = 0;
+		m_FrameCount = 0;
+		m_Remainder = 0.0;
+		m_Paused = false;
+		m_TimeScale = 1.0f;
+		m_FixedStep = 0;
+	}//Constructor
+
+	SFrameClock::~SFrameClock(void) {
+		clear();
+	}//Destructor
+
+	void SFrameClock::init(void) {
+		clear();
+		m_Start = now();
+	}//initialize
+
+	void SFrameClock::clear(void) {
+		m_Start = 0;
+		m_RealTime = 0;
+		m_RealDelta = 0;
+		m_Time = 0;
+		m_Delta = 0;
+		m_FrameCount = 0;
+		m_Remainder = 0.0;
+		m_Paused = false;
+		m_TimeScale = 1.0f;
+		m_FixedStep = 0;
+	}//clear
+
+	void SFrameClock::tick(void) {
+		const uint64_t RealTime = now() - m_Start;
+		m_RealDelta = RealTime - m_RealTime;
+		m_RealTime = RealTime;
+		m_FrameCount++;
+
+		if (1 == m_FrameCount) {
+			// continue from the real time frame time followed before the first tick
+			m_Delta = RealTime;
+		}
+		else if (m_Paused) {
+			m_Delta = 0;
+		}
+		else if (0 != m_FixedStep) {
+			m_Delta = m_FixedStep;
+		}
+		else {
+			// keep fractions, so small time scales do not stop the clock
+			const double Scaled = double(m_RealDelta) * double(m_TimeScale) + m_Remainder;
+			m_Delta = uint64_t(std::floor(Scaled));
+			m_Remainder = Scaled - double(m_Delta);
+		}
+		m_Time += m_Delta;
+	}//tick
+
+	uint64_t SFrameClock::time(void)const {
+		return (0 == m_FrameCount) ? now() - m_Start : m_Time;
+	}//time
+
+	uint64_t SFrameClock::delta(void)const {
+		return m_Delta;
+	}//delta
+
+	float SFrameClock::seconds(void)const {
+		return float(double(time()) / 1000000.0);
+	}//seconds
+
+	float SFrameClock::deltaSeconds(void)const {
+		return float(double(m_Delta) / 1000000.0);
+	}//deltaSeconds
+
+	uint64_t SFrameClock::realTime(void)const {
+		return m_RealTime;
+	}//realTime
+
+	uint64_t SFrameClock::realDelta(void)const {
+		return m_RealDelta;
+	}//realDelta
+
+	uint64_t SFrameClock::frameCount(void)const {
+		return m_FrameCount;
+	}//frameCount
+
+	void SFrameClock::pause(bool Paused) {
+		m_Paused = Paused;
+	}//pause
+
+	bool SFrameClock::paused(void)const {
+		return m_Paused;
+	}//paused
+
+	void SFrameClock::timeScale(float Scale) {
+		if (Scale < 0.0f) throw CForgeExcept("Time scale must not be negative!");
+		m_TimeScale = Scale;
+	}//timeScale
+
+	float SFrameClock::timeScale(void)const {
+		return m_TimeScale;
+	}//timeScale
+
+	void SFrameClock::fixedStep(uint64_t Microseconds) {
+		m_FixedStep = Microseconds;
+	}//fixedStep
+
+	uint64_t SFrameClock::fixedStep(void)const {
+		return m_FixedStep;
+	}//fixedStep
+
+}//name space
@@ -0,0 +1,103 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): SFrameClock.h and SFrameClock.cpp                                *
+*                                                                           *
+* Content: Monotonic clock sampled once per frame and shared by all        *
+*          controllers and actors.                                          *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_SFRAMECLOCK_H__
+#define __CFORGE_SFRAMECLOCK_H__
+
+#include "CForgeObject.h"
+
+namespace CForge {
+	/**
+	* \brief Frame clock in microseconds based on std::chrono::steady_clock. The application calls tick once per frame, everything else reads the time of the current frame instead of querying the system clock.
+	*
+	* Frame time advances by the real time elapsed since the last tick multiplied by the time scale and stands still while paused. With a fixed step every tick advances the frame time by exactly that step, independent of the real time. That replays animations identically on every run, e.g. for benchmarks or recording videos. Real time keeps running in all modes and serves for frame rate measurement. Until the first tick frame time follows real time, so readers get a running clock even if the application does not tick it. The first tick continues from there, time scale, pause and fixed step apply from the second tick on.
+	*
+	* \todo Do full documentation
+	* \ingroup Core
+	*/
+	class CFORGE_API SFrameClock : public CForgeObject {
+	public:
+		/**
+		*\brief Instantiation method.
+		* \return Pointer to the unique instance.
+		*/
+		static SFrameClock* instance(void);
+
+		/**
+		*\brief Release method. Call once for every instance call.
+		*/
+		void release(void);
+
+		/**
+		* \brief Current time of the steady clock in microseconds. Not related to frame time, use for measuring durations.
+		*/
+		static uint64_t now(void);
+
+		/**
+		* \brief Samples the clock and advances the frame. Call once per frame.
+		*/
+		void tick(void);
+
+		uint64_t time(void)const; ///< Frame time in microseconds since the clock was created. Real time if the clock was never ticked.
+		uint64_t delta(void)const; ///< Frame time in microseconds the last tick advanced.
+		float seconds(void)const; ///< Frame time in seconds.
+		float deltaSeconds(void)const; ///< Frame time in seconds the last tick advanced.
+
+		uint64_t realTime(void)const; ///< Unscaled time in microseconds since the clock was created, sampled at the last tick.
+		uint64_t realDelta(void)const; ///< Unscaled time in microseconds between the last two ticks.
+		uint64_t frameCount(void)const; ///< Number of ticks.
+
+		void pause(bool Paused);
+		bool paused(void)const;
+
+		void timeScale(float Scale);
+		float timeScale(void)const;
+
+		/**
+		* \brief Sets a fixed step for replay.
+		* \param[in] Microseconds Frame time every tick advances by. 0 returns to real time.
+		*/
+		void fixedStep(uint64_t Microseconds);
+		uint64_t fixedStep(void)const;
+
+	protected:
+		SFrameClock(void);
+		~SFrameClock(void);
+
+		void init(void);
+		void clear(void);
+
+	private:
+		static SFrameClock* m_pInstance;	///< Holds the unique instance pointer.
+		static int16_t m_InstanceCount; ///< Number of instance calls. If down to zero the object gets destroyed.
+
+		uint64_t m_Start; ///< Steady clock at creation
+		uint64_t m_RealTime;
+		uint64_t m_RealDelta;
+		uint64_t m_Time;
+		uint64_t m_Delta;
+		uint64_t m_FrameCount;
+		double m_Remainder; ///< Fraction of a microsecond left over by time scaling
+
+		bool m_Paused;
+		float m_TimeScale;
+		uint64_t m_FixedStep;
+	};//SFrameClock
+
+}//name space
+
+#endif
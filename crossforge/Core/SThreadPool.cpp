@@ -0,0 +1,148 @@
+#include <algorithm>
+#include "SThreadPool.h"
+
+namespace CForge {
+
+	SThreadPool* SThreadPool::m_pInstance = nullptr;
+	int16_t SThreadPool::m_InstanceCount = 0;
+
+	// set for worker threads and threads currently submitting a job, to catch nested calls
+	static thread_local bool t_InsideJob = false;
+
+	SThreadPool* SThreadPool::instance(void) {
+		if (nullptr == m_pInstance) {
+			m_pInstance = new SThreadPool();
+			m_pInstance->init();
+		}
+		m_InstanceCount++;
+		return m_pInstance;
+	}//instance
+
+	void SThreadPool::release(void) {
+		if (0 == m_InstanceCount) throw CForgeExcept("Not enough instances for a release call!");
+		m_InstanceCount--;
+		if (0 == m_InstanceCount) {
+			delete m_pInstance;
+			m_pInstance = nullptr;
+		}
+	}//release
+
+	SThreadPool::SThreadPool(void): CForgeObject("SThreadPool") {
+		m_Shutdown = false;
+		m_Generation = 0;
+		m_ActiveWorkers = 0;
+		m_pJob = nullptr;
+		m_Count = 0;
+		m_BatchSize = 1;
+		m_Next = 0;
+	}//Constructor
+
+	SThreadPool::~SThreadPool(void) {
+		clear();
+	}//Destructor
+
+	void SThreadPool::init(void) {
+		clear();
+		m_Shutdown = false;
+#ifndef __EMSCRIPTEN__
+		const uint32_t HardwareThreads = std::thread::hardware_concurrency();
+		const uint32_t WorkerCount = (HardwareThreads > 1) ? HardwareThreads - 1 : 0;
+		for (uint32_t i = 0; i < WorkerCount; ++i) m_Workers.push_back(std::thread(&SThreadPool::workerLoop, this));
+#endif
+	}//initialize
+
+	void SThreadPool::clear(void) {
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_Shutdown = true;
+		}
+		m_WakeUp.notify_all();
+		for (auto& i : m_Workers) {
+			if (i.joinable()) i.join();
+		}
+		m_Workers.clear();
+	}//clear
+
+	uint32_t SThreadPool::workerCount(void)const {
+		return uint32_t(m_Workers.size());
+	}//workerCount
+
+	void SThreadPool::parallelFor(uint32_t Count, const std::function<void(uint32_t)>& Job, uint32_t BatchSize) {
+		if (0 == Count) return;
+		if (0 == BatchSize) BatchSize = 1;
+
+		// serial fallback: no workers, tiny jobs, nested calls, or the pool is busy with another thread's job
+		std::unique_lock<std::mutex> SubmitLock(m_SubmitMutex, std::defer_lock);
+		if (m_Workers.empty() || Count <= BatchSize || t_InsideJob || !SubmitLock.try_lock()) {
+			for (uint32_t i = 0; i < Count; ++i) Job(i);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_pJob = &Job;
+			m_Count = Count;
+			m_BatchSize = BatchSize;
+			m_Next = 0;
+			m_Exception = nullptr;
+			m_Generation++;
+		}
+		m_WakeUp.notify_all();
+
+		t_InsideJob = true;
+		processBatches();
+		t_InsideJob = false;
+
+		// all batches are taken, wait for the workers still processing theirs
+		std::exception_ptr Exception = nullptr;
+		{
+			std::unique_lock<std::mutex> Lock(m_Mutex);
+			m_Done.wait(Lock, [this] { return 0 == m_ActiveWorkers; });
+			m_pJob = nullptr;
+			Exception = m_Exception;
+			m_Exception = nullptr;
+		}
+
+		if (nullptr != Exception) std::rethrow_exception(Exception);
+	}//parallelFor
+
+	void SThreadPool::workerLoop(void) {
+		t_InsideJob = true;
+		uint64_t Generation = 0;
+
+		while (true) {
+			{
+				std::unique_lock<std::mutex> Lock(m_Mutex);
+				m_WakeUp.wait(Lock, [&] { return m_Shutdown || (m_Generation != Generation && nullptr != m_pJob); });
+				if (m_Shutdown) break;
+				Generation = m_Generation;
+				m_ActiveWorkers++;
+			}
+
+			processBatches();
+
+			{
+				std::lock_guard<std::mutex> Lock(m_Mutex);
+				m_ActiveWorkers--;
+			}
+			m_Done.notify_all();
+		}//while[true]
+	}//workerLoop
+
+	void SThreadPool::processBatches(void) {
+		while (true) {
+			const uint32_t Begin = m_Next.fetch_add(m_BatchSize);
+			if (Begin >= m_Count) break;
+			const uint32_t End = std::min(Begin + m_BatchSize, m_Count);
+
+			try {
+				for (uint32_t i = Begin; i < End; ++i) (*m_pJob)(i);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> Lock(m_Mutex);
+				if (nullptr == m_Exception) m_Exception = std::current_exception();
+			}
+		}//while[batches left]
+	}//processBatches
+
+}//name space
@@ -0,0 +1,97 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): SThreadPool.h and SThreadPool.cpp                                *
+*                                                                           *
+* Content: Pool of worker threads to process data parallel jobs.           *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_STHREADPOOL_H__
+#define __CFORGE_STHREADPOOL_H__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include "CForgeObject.h"
+
+namespace CForge {
+	/**
+	* \brief Pool of worker threads (one less than hardware threads) to run data parallel jobs.
+	*
+	* parallelFor blocks until all indices are processed. The calling thread takes part in the work. Nested calls from within a job and concurrent calls from other threads are processed serially on the calling thread. Builds without thread support (Emscripten) process everything on the calling thread.
+	*
+	* \todo Do full documentation
+	* \ingroup Core
+	*/
+	class CFORGE_API SThreadPool : public CForgeObject {
+	public:
+		/**
+		*\brief Instantiation method.
+		* \return Pointer to the unique instance.
+		*/
+		static SThreadPool* instance(void);
+
+		/**
+		*\brief Release method. Call once for every instance call.
+		*/
+		void release(void);
+
+		/**
+		* \brief Calls Job(i) for every i in [0, Count), distributed over the worker threads. Returns after all calls finished. The first exception thrown by a job gets rethrown.
+		*
+		* \param[in] Count Number of indices.
+		* \param[in] Job Function to call for each index.
+		* \param[in] BatchSize Number of consecutive indices a thread takes at once.
+		*/
+		void parallelFor(uint32_t Count, const std::function<void(uint32_t)>& Job, uint32_t BatchSize = 1);
+
+		/**
+		* \brief Number of worker threads (without the calling thread).
+		*/
+		uint32_t workerCount(void)const;
+
+	protected:
+		SThreadPool(void);
+		~SThreadPool(void);
+
+		void init(void);
+		void clear(void);
+
+		void workerLoop(void);
+		void processBatches(void);
+
+	private:
+		static SThreadPool* m_pInstance;	///< Holds the unique instance pointer.
+		static int16_t m_InstanceCount; ///< Number of instance calls. If down to zero the object gets destroyed.
+
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::mutex m_SubmitMutex; ///< Only one job at a time.
+		std::condition_variable m_WakeUp;
+		std::condition_variable m_Done;
+		bool m_Shutdown;
+		uint64_t m_Generation; ///< Incremented for every job, wakes up the workers.
+		uint32_t m_ActiveWorkers;
+
+		// current job
+		const std::function<void(uint32_t)>* m_pJob;
+		uint32_t m_Count;
+		uint32_t m_BatchSize;
+		std::atomic<uint32_t> m_Next;
+		std::exception_ptr m_Exception;
+	};//SThreadPool
+
+}//name space
+
+#endif
@@ -0,0 +1,103 @@
+#include "SimulationThread.h"
+
+namespace CForge {
+
+	SimulationThread::SimulationThread(void): CForgeObject("SimulationThread") {
+		m_StepPending = false;
+		m_Shutdown = false;
+		m_StepCount = 0;
+		m_Exception = nullptr;
+	}//Constructor
+
+	SimulationThread::~SimulationThread(void) {
+		clear();
+	}//Destructor
+
+	void SimulationThread::init(std::function<void(void)> Simulate, std::function<void(void)> Swap) {
+		if (!Simulate) throw NullpointerExcept("Simulate");
+		clear();
+
+		m_Simulate = Simulate;
+		m_Swap = Swap;
+		m_Shutdown = false;
+		m_StepCount = 0;
+#ifndef __EMSCRIPTEN__
+		m_Thread = std::thread(&SimulationThread::threadLoop, this);
+#endif
+	}//initialize
+
+	void SimulationThread::clear(void) {
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_Shutdown = true;
+		}
+		m_WakeUp.notify_all();
+		if (m_Thread.joinable()) m_Thread.join();
+
+		m_StepPending = false;
+		m_Exception = nullptr;
+		m_Simulate = nullptr;
+		m_Swap = nullptr;
+	}//clear
+
+	void SimulationThread::fence(void) {
+		if (!m_Simulate) throw NotInitializedExcept("Simulation thread was not initialized!");
+
+#ifdef __EMSCRIPTEN__
+		m_Simulate();
+		m_StepCount++;
+		if (m_Swap) m_Swap();
+#else
+		wait();
+		// simulation is idle, safe to publish its state
+		if (m_Swap) m_Swap();
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_StepPending = true;
+		}
+		m_WakeUp.notify_one();
+#endif
+	}//fence
+
+	void SimulationThread::wait(void) {
+		std::exception_ptr Exception = nullptr;
+		{
+			std::unique_lock<std::mutex> Lock(m_Mutex);
+			m_Done.wait(Lock, [this] { return !m_StepPending; });
+			Exception = m_Exception;
+			m_Exception = nullptr;
+		}
+		if (nullptr != Exception) std::rethrow_exception(Exception);
+	}//wait
+
+	uint64_t SimulationThread::stepCount(void)const {
+		return m_StepCount;
+	}//stepCount
+
+	void SimulationThread::threadLoop(void) {
+		while (true) {
+			{
+				std::unique_lock<std::mutex> Lock(m_Mutex);
+				m_WakeUp.wait(Lock, [this] { return m_Shutdown || m_StepPending; });
+				if (m_Shutdown) break;
+			}
+
+			std::exception_ptr Exception = nullptr;
+			try {
+				m_Simulate();
+			}
+			catch (...) {
+				Exception = std::current_exception();
+			}
+
+			{
+				std::lock_guard<std::mutex> Lock(m_Mutex);
+				m_Exception = Exception;
+				m_StepCount++;
+				m_StepPending = false;
+			}
+			m_Done.notify_all();
+		}//while[running]
+	}//threadLoop
+
+}//name space
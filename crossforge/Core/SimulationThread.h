@@ -0,0 +1,82 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): SimulationThread.h and SimulationThread.cpp                      *
+*                                                                           *
+* Content: Runs simulation steps on a separate thread, synchronized with   *
+*          the render loop by a frame fence.                                *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_SIMULATIONTHREAD_H__
+#define __CFORGE_SIMULATIONTHREAD_H__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include "CForgeObject.h"
+
+namespace CForge {
+	/**
+	* \brief Runs game logic, e.g. SceneGraph::update, on its own thread while the render thread draws the previous frame.
+	*
+	* The render loop calls fence once per frame. The fence waits for the running simulation step, calls the swap function to publish the simulated state (e.g. SceneGraph::commitState or DoubleBuffer::publish) and starts the next step. Rendering then overlaps with the simulation and shows the state one step behind. Everything the simulation writes must be double buffered, structural changes (adding nodes, creating actors, OpenGL calls) belong into the swap function or the render thread.
+	*
+	* Builds without thread support (Emscripten) run the step inside the fence.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API SimulationThread : public CForgeObject {
+	public:
+		SimulationThread(void);
+		~SimulationThread(void);
+
+		/**
+		* \brief Starts the thread.
+		* \param[in] Simulate Simulation step, runs on the simulation thread.
+		* \param[in] Swap Publishes the simulated state, runs on the thread calling fence while the simulation is idle.
+		*/
+		void init(std::function<void(void)> Simulate, std::function<void(void)> Swap);
+		void clear(void);
+
+		/**
+		* \brief Frame fence. Waits for the running step, swaps and starts the next step. Exceptions thrown by the step get rethrown here.
+		*/
+		void fence(void);
+
+		/**
+		* \brief Waits for the running step without starting another one.
+		*/
+		void wait(void);
+
+		uint64_t stepCount(void)const; ///< Number of finished steps.
+
+	protected:
+		void threadLoop(void);
+
+		std::thread m_Thread;
+		std::mutex m_Mutex;
+		std::condition_variable m_WakeUp;
+		std::condition_variable m_Done;
+		bool m_StepPending; ///< Step started but not finished
+		bool m_Shutdown;
+		std::atomic<uint64_t> m_StepCount;
+		std::exception_ptr m_Exception;
+
+		std::function<void(void)> m_Simulate;
+		std::function<void(void)> m_Swap;
+	};//SimulationThread
+
+}//name space
+
+#endif
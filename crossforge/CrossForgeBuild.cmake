@@ -112,6 +112,7 @@ else()
 	FIND_PACKAGE(freetype REQUIRED)		# Library to load and process vector based fonts
 	FIND_PACKAGE(libigl CONFIG REQUIRED)	# mesh processing library
 	FIND_PACKAGE(WebP CONFIG REQUIRED)	# WebP to import/export webp
+	FIND_PACKAGE(Threads REQUIRED)		# std::thread support for the thread pool
 
 endif()
 
@@ -146,6 +147,9 @@ add_library(crossforge SHARED
 	crossforge/Core/SCrossForgeDevice.cpp
 	crossforge/Core/SGPIO.cpp
 	crossforge/Core/SLogger.cpp
+	crossforge/Core/SFrameClock.cpp
+	crossforge/Core/SThreadPool.cpp
+	crossforge/Core/SimulationThread.cpp
 	
 	
 	# Asset import/exporter stuff
@@ -167,6 +171,7 @@ add_library(crossforge SHARED
 	crossforge/Graphics/GLWindow.cpp 
 	crossforge/Graphics/RenderDevice.cpp 
 	crossforge/Graphics/RenderMaterial.cpp 
+	crossforge/Graphics/RenderQueue.cpp
 	crossforge/Graphics/STextureManager.cpp 
 	crossforge/Graphics/VirtualCamera.cpp
 
@@ -184,10 +189,16 @@ add_library(crossforge SHARED
 	crossforge/Graphics/Actors/SkeletalActor.cpp 
 	crossforge/Graphics/Actors/MorphTargetActor.cpp 
 	crossforge/Graphics/Actors/StickFigureActor.cpp
+	crossforge/Graphics/Actors/VertexAnimationActor.cpp
+	crossforge/Graphics/Actors/SkinningPaletteTexture.cpp
+	crossforge/Graphics/Actors/SkeletalCrowdActor.cpp
 
 	# Animation Controller 
 	crossforge/Graphics/Controller/SkeletalAnimationController.cpp 
+	crossforge/Graphics/Controller/SkeletalAnimationSystem.cpp
+	crossforge/Graphics/Controller/SkeletalPoseCache.cpp
 	crossforge/Graphics/Controller/MorphTargetAnimationController.cpp
+	crossforge/Graphics/Controller/VertexAnimationBaker.cpp
 
 	# Shader
 	crossforge/Graphics/Shader/GLShader.cpp 
@@ -203,6 +214,8 @@ add_library(crossforge SHARED
 	crossforge/Graphics/UniformBufferObjects/UBOBoneData.cpp 
 	crossforge/Graphics/UniformBufferObjects/UBOMorphTargetData.cpp
 	crossforge/Graphics/UniformBufferObjects/UBOTextData.cpp
+	crossforge/Graphics/UniformBufferObjects/UBOVertexAnimationData.cpp
+	crossforge/Graphics/UniformBufferObjects/UBOSkinningPaletteData.cpp
 
 	# Lights
 	crossforge/Graphics/Lights/ILight.cpp 
@@ -215,6 +228,7 @@ add_library(crossforge SHARED
 	crossforge/Graphics/SceneGraph/SceneGraph.cpp 
 	crossforge/Graphics/SceneGraph/SGNGeometry.cpp
 	crossforge/Graphics/SceneGraph/SGNTransformation.cpp
+	crossforge/Graphics/SceneGraph/TransformHierarchy.cpp
 
 	# Font
 	crossforge/Graphics/Font/Font.cpp
@@ -236,6 +250,8 @@ add_library(crossforge SHARED
 
 	# Mesh Processing
 	crossforge/MeshProcessing/Builder/MorphTargetModelBuilder.cpp
+	crossforge/MeshProcessing/CPUSkinning.cpp
+	crossforge/MeshProcessing/CPUMorphTargetBlending.cpp
 	crossforge/MeshProcessing/PrimitiveShapeFactory.cpp
 
 
@@ -268,6 +284,7 @@ target_link_libraries(crossforge
 	PRIVATE igl::igl_core 	
 	PRIVATE WebP::webp 
 	PRIVATE WebP::webpdecoder
+	PRIVATE Threads::Threads
 	ws2_32					#winsock2
 	${FREETYPE_LIBRARIES}	# for Text rendering
 	${OpenCV_LIBS}
@@ -283,6 +300,7 @@ elseif(__arm__)
 	PRIVATE igl::igl_core 
 	PRIVATE WebP::webp 
 	PRIVATE WebP::webpdecoder
+	PRIVATE Threads::Threads
 	${FREETYPE_LIBRARIES}	# for Text rendering
 	freetype
 #	${OpenCV_LIBS}
@@ -300,6 +318,7 @@ elseif(UNIX)
 	PRIVATE igl::igl_core 
 	PRIVATE WebP::webp 
 	PRIVATE WebP::webpdecoder
+	PRIVATE Threads::Threads
 	${FREETYPE_LIBRARIES}	# for Text rendering
 	freetype
 #	${OpenCV_LIBS}
@@ -6,6 +6,8 @@ namespace CForge {
 
 	IRenderableActor::IRenderableActor(const std::string ClassName, int32_t ActorType): CForgeObject("IRenderableActor::" + ClassName) {
 		m_TypeID = ActorType;
+		m_InstancesChanged = false;
+		m_BVVersion = 0;
 	}//Constructor
 
 	IRenderableActor::~IRenderableActor(void) {
@@ -64,6 +66,48 @@ namespace CForge {
 		}
 	}//setBufferData
 
+	void IRenderableActor::initInstanceBuffer(void) {
+		// layout per instance: model matrix (16 floats) followed by normal matrix (9 floats), column major
+		const uint32_t Stride = 25 * sizeof(float);
+		const uint32_t ModelLoc = GLShader::attribArrayIndex(GLShader::ATTRIB_INSTANCE_MODELMATRIX);
+		const uint32_t NormalLoc = GLShader::attribArrayIndex(GLShader::ATTRIB_INSTANCE_NORMALMATRIX);
+
+		m_InstanceBuffer.init(GLBuffer::BTYPE_VERTEX, GLBuffer::BUSAGE_DYNAMIC_DRAW);
+		m_InstanceBuffer.bind();
+		for (uint32_t i = 0; i < 4; ++i) {
+			glEnableVertexAttribArray(ModelLoc + i);
+			glVertexAttribPointer(ModelLoc + i, 4, GL_FLOAT, GL_FALSE, Stride, (const void*)(uint64_t(i * 4 * sizeof(float))));
+			glVertexAttribDivisor(ModelLoc + i, 1);
+		}
+		for (uint32_t i = 0; i < 3; ++i) {
+			glEnableVertexAttribArray(NormalLoc + i);
+			glVertexAttribPointer(NormalLoc + i, 3, GL_FLOAT, GL_FALSE, Stride, (const void*)(uint64_t((16 + i * 3) * sizeof(float))));
+			glVertexAttribDivisor(NormalLoc + i, 1);
+		}
+		m_InstanceBuffer.unbind();
+
+		m_isInstanced = true;
+
+		// non instanced draws keep the attributes enabled, so always provide valid data
+		const Eigen::Matrix4f Identity = Eigen::Matrix4f::Identity();
+		instanceData(&Identity, 1);
+	}//initInstanceBuffer
+
+	void IRenderableActor::instanceData(const Eigen::Matrix4f* pModelMatrices, uint32_t Count) {
+		if (nullptr == pModelMatrices) throw NullpointerExcept("pModelMatrices");
+		if (!m_isInstanced) throw CForgeExcept("Actor " + m_TypeName + " does not support instancing!");
+
+		m_InstanceData.resize(Count * 25);
+		float* pData = m_InstanceData.data();
+		for (uint32_t i = 0; i < Count; ++i) {
+			const Eigen::Matrix3f NormalMat = pModelMatrices[i].block<3, 3>(0, 0).inverse().transpose();
+			memcpy(&pData[0], pModelMatrices[i].data(), 16 * sizeof(float));
+			memcpy(&pData[16], NormalMat.data(), 9 * sizeof(float));
+			pData += 25;
+		}//for[instances]
+		m_InstanceBuffer.bufferData(m_InstanceData.data(), m_InstanceData.size() * sizeof(float));
+	}//instanceData
+
 	uint32_t IRenderableActor::materialCount(void) const {
 		return m_RenderGroupUtility.renderGroupCount();
 	}//materialCount
@@ -86,8 +130,50 @@ namespace CForge {
 		if (BV.type() == BoundingVolume::TYPE_UNKNOWN) m_BV.clear();
 		else if (BV.type() == BoundingVolume::TYPE_AABB) m_BV.init(BV.aabb());
 		else if (BV.type() == BoundingVolume::TYPE_SPHERE) m_BV.init(BV.boundingSphere());
+		m_BVVersion++;
 	}//boundingVolume
 
+	bool IRenderableActor::dynamicBoundingVolume(void)const {
+		// instances may be replaced every frame
+		return m_isManualInstaned;
+	}//dynamicBoundingVolume
+
+	uint32_t IRenderableActor::boundingVolumeVersion(void)const {
+		return m_BVVersion;
+	}//boundingVolumeVersion
+
+	bool IRenderableActor::renderGroupsQueueable(void)const {
+		return false;
+	}//renderGroupsQueueable
+
+	GLShader* IRenderableActor::renderGroupShader(RenderDevice* pRDev, uint32_t GroupIndex, bool Instanced) {
+		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
+		// instanced variants are only compiled for actors that actually get rendered instanced
+		if (Instanced) m_RenderGroupUtility.buildInstancedShaders();
+		const RenderGroupUtility::RenderGroup* pGroup = m_RenderGroupUtility.renderGroup(GroupIndex);
+
+		GLShader* pRval = nullptr;
+		switch (pRDev->activePass()) {
+		case RenderDevice::RENDERPASS_SHADOW: pRval = (Instanced) ? pGroup->pShaderShadowPassInstanced : pGroup->pShaderShadowPass; break;
+		case RenderDevice::RENDERPASS_GEOMETRY: pRval = (Instanced) ? pGroup->pShaderGeometryPassInstanced : pGroup->pShaderGeometryPass; break;
+		case RenderDevice::RENDERPASS_FORWARD: pRval = (Instanced) ? pGroup->pShaderForwardPassInstanced : pGroup->pShaderForwardPass; break;
+		default: break;
+		}
+		return pRval;
+	}//renderGroupShader
+
+	void IRenderableActor::renderGroup(RenderDevice* pRDev, uint32_t GroupIndex, bool BindVertexArray) {
+		throw CForgeExcept("Actor " + m_TypeName + " does not support rendering of single render groups!");
+	}//renderGroup
+
+	void IRenderableActor::renderGroupInstanced(RenderDevice* pRDev, uint32_t GroupIndex, uint32_t InstanceCount, bool BindVertexArray) {
+		throw CForgeExcept("Actor " + m_TypeName + " does not support instanced rendering!");
+	}//renderGroupInstanced
+
+	uint32_t IRenderableActor::vertexArrayID(void)const {
+		return m_VertexArray.objectID();
+	}//vertexArrayID
+
 
 
 	T3DMesh<float>::AABB IRenderableActor::getAABB()
@@ -130,9 +216,24 @@ namespace CForge {
 
 	}
 
-	void IRenderableActor::addInstance(Eigen::Matrix4f matrix) {
-
-	}
+	void IRenderableActor::addInstance(Eigen::Matrix4f Matrix) {
+		if (!m_isInstanced) throw CForgeExcept("Actor " + m_TypeName + " does not support instancing!");
+		m_Instances.push_back(Matrix);
+		m_isManualInstaned = true;
+		m_InstancesChanged = true;
+		m_BVVersion++;
+	}//addInstance
+
+	void IRenderableActor::clearInstances(void) {
+		m_Instances.clear();
+		m_isManualInstaned = false;
+		m_InstancesChanged = true;
+		m_BVVersion++;
+	}//clearInstances
+
+	uint32_t IRenderableActor::instanceCount(void)const {
+		return uint32_t(m_Instances.size());
+	}//instanceCount
 
 	void IRenderableActor::evaluateQueryResult(Eigen::Matrix4f mat, uint32_t pixelCount) {
 	
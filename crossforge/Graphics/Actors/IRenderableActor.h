@@ -39,6 +39,8 @@ namespace CForge {
 			ATYPE_STATIC = 0,
 			ATYPE_SKELETAL = 1,
 			ATYPE_SCREENQUAD = 2,
+			ATYPE_VERTEXANIMATION = 6,
+			ATYPE_SKELETALCROWD = 7,
 		};
 
 		virtual void release(void) = 0;
@@ -52,6 +54,23 @@ namespace CForge {
 
 		virtual BoundingVolume boundingVolume(void)const;
 		virtual void boundingVolume(const BoundingVolume BV);
+		/**
+		* \brief Whether the bounding volume may change without the scene graph being notified, e.g. with every animated pose. Scene graph nodes never cache bounds of such actors. Manually instanced actors report a dynamic volume.
+		*/
+		virtual bool dynamicBoundingVolume(void)const;
+		/**
+		* \brief Changes whenever the bounding volume or the manual instances change, so scene graph nodes notice changes of actors whose bounds they cached.
+		*/
+		uint32_t boundingVolumeVersion(void)const;
+
+		/**
+		* \brief Whether the actor can render each of its render groups individually. Only those actors get sorted per render group by the render queue.
+		*/
+		virtual bool renderGroupsQueueable(void)const;
+		virtual GLShader* renderGroupShader(class RenderDevice* pRDev, uint32_t GroupIndex, bool Instanced);
+		virtual void renderGroup(class RenderDevice* pRDev, uint32_t GroupIndex, bool BindVertexArray);
+		virtual void renderGroupInstanced(class RenderDevice* pRDev, uint32_t GroupIndex, uint32_t InstanceCount, bool BindVertexArray);
+		uint32_t vertexArrayID(void)const;
 		
 		// 
 		virtual void testAABBvis(RenderDevice* pRDev, Eigen::Matrix4f sgMat);
@@ -62,7 +81,17 @@ namespace CForge {
 		bool isInstanced();
 		bool isManualInstanced();
 
-		virtual void addInstance(Eigen::Matrix4f matrix);
+		/**
+		* \brief Adds an instance with a transformation relative to the one the actor gets rendered with. Once instances were added, every render call draws all instances at once.
+		*/
+		virtual void addInstance(Eigen::Matrix4f Matrix);
+		virtual void clearInstances(void);
+		uint32_t instanceCount(void)const;
+
+		/**
+		* \brief Uploads per instance model matrices (normal matrices are derived) to the instance buffer. Requires an actor with instancing support.
+		*/
+		void instanceData(const Eigen::Matrix4f* pModelMatrices, uint32_t Count);
 		bool isInLODSG();
 		// used set check if actor is already contained in LODSG
 		void setLODSG(bool inside);
@@ -78,10 +107,12 @@ namespace CForge {
 		virtual ~IRenderableActor(void);
 
 		virtual void setBufferData(void);
+		void initInstanceBuffer(void); ///< Creates the instance buffer and attaches its attributes to the bound vertex array
 
 		GLBuffer m_VertexBuffer; ///< stores vertex data
 		GLBuffer m_ElementBuffer; ///< stores triangle indexes
 		GLVertexArray m_VertexArray; ///< the vertex array
+		GLBuffer m_InstanceBuffer; ///< per instance model and normal matrices
 
 		VertexUtility m_VertexUtility;
 		RenderGroupUtility m_RenderGroupUtility;
@@ -90,6 +121,11 @@ namespace CForge {
 		std::string m_TypeName;
 
 		BoundingVolume m_BV;
+		uint32_t m_BVVersion; ///< See boundingVolumeVersion
+
+		std::vector<Eigen::Matrix4f> m_Instances; ///< Manually added instances
+		std::vector<float> m_InstanceData; ///< Staging memory for the instance buffer
+		bool m_InstancesChanged;
 		
 		//
 		bool m_isInstanced = false;
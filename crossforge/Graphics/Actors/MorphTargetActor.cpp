@@ -1,6 +1,8 @@
 #include "../OpenGLHeader.h"
 #include "../RenderDevice.h"
 #include "MorphTargetActor.h"
+#include "../Shader/ShaderCode.h"
+#include "../../Core/SLogger.h"
 #include "../../Utility/CForgeUtility.h"
 
 using namespace Eigen;
@@ -8,7 +10,13 @@ using namespace Eigen;
 namespace CForge {
 
 	MorphTargetActor::MorphTargetActor(void): IRenderableActor("MorphTargetActor", 5) {
-
+		m_MorphTargetTexture = GL_INVALID_INDEX;
+		m_MorphTargetIndexTexture = GL_INVALID_INDEX;
+		m_MorphTargetWeightTexture = GL_INVALID_INDEX;
+		m_TextureWidth = 0;
+		m_MorphTargetCount = 0;
+		m_BlendingMode = BLENDING_CPU;
+		m_pAnimationController = nullptr;
 
 	}//Constructor
 
@@ -16,7 +24,7 @@ namespace CForge {
 		clear();
 	}//Destructor
 
-	void MorphTargetActor::init(T3DMesh<float>* pMesh, MorphTargetAnimationController *pController) {
+	void MorphTargetActor::init(T3DMesh<float>* pMesh, MorphTargetAnimationController *pController, BlendingMode Mode, bool HalfFloatDeltas) {
 		clear();
 		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
 		if (pMesh->vertexCount() == 0) throw CForgeExcept("Mesh contains no vertex data. Can not initialize!");
@@ -36,7 +44,9 @@ namespace CForge {
 		pBuffer = nullptr;
 		BufferSize = 0;
 
-		m_RenderGroupUtility.init(pMesh, (void**)&pBuffer, &BufferSize);
+		// blending on the CPU requires the plain shaders
+		const uint16_t VSDisabledOptions = (Mode == BLENDING_CPU) ? ShaderCode::CONF_MORPHTARGETANIMATION : 0;
+		m_RenderGroupUtility.init(pMesh, (void**)&pBuffer, &BufferSize, false, 0, VSDisabledOptions);
 		// build index buffer
 		m_ElementBuffer.init(GLBuffer::BTYPE_INDEX, GLBuffer::BUSAGE_STATIC_DRAW, pBuffer, BufferSize);
 
@@ -47,12 +57,15 @@ namespace CForge {
 		m_VertexArray.init();
 		m_VertexArray.bind();
 		setBufferData();
+		if (Mode == BLENDING_CPU) initDeformedBuffer(pMesh);
 		m_VertexArray.unbind();
 
-		buildMorphTargetBuffer(pMesh);
-
-		m_MorphTargetUBO.init();
-		m_MorphTargetUBO.dataOffset(pMesh->vertexCount());
+		m_BlendingMode = Mode;
+		if (Mode == BLENDING_VERTEXSHADER) {
+			buildMorphTargetBuffer(pMesh, HalfFloatDeltas);
+			m_MorphTargetUBO.init();
+			m_MorphTargetUBO.layout(m_TextureWidth, pMesh->morphTargetCount());
+		}
 
 		m_pAnimationController = pController;
 
@@ -68,8 +81,18 @@ namespace CForge {
 		m_VertexArray.clear();
 		m_VertexBuffer.clear();
 		m_VertexUtility.clear();
+		m_DeformedBuffer.clear();
+		m_Blending.clear();
 		if (glIsTexture(m_MorphTargetTexture)) glDeleteTextures(1, &m_MorphTargetTexture);
+		if (glIsTexture(m_MorphTargetIndexTexture)) glDeleteTextures(1, &m_MorphTargetIndexTexture);
+		if (glIsTexture(m_MorphTargetWeightTexture)) glDeleteTextures(1, &m_MorphTargetWeightTexture);
 		m_MorphTargetTexture = GL_INVALID_INDEX;
+		m_MorphTargetIndexTexture = GL_INVALID_INDEX;
+		m_MorphTargetWeightTexture = GL_INVALID_INDEX;
+		m_TextureWidth = 0;
+		m_MorphTargetCount = 0;
+		m_Weights.clear();
+		m_FrameWeights.clear();
 	}//clear
 
 	void MorphTargetActor::release(void) {
@@ -80,56 +103,28 @@ namespace CForge {
 		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
 
 		
-		// create UBO data
-		m_pAnimationController->apply(&m_ActiveAnimations, &m_MorphTargetUBO);
+		// weights only get uploaded if they changed, so further passes of the frame are free
+		if (nullptr != m_pAnimationController) m_pAnimationController->apply(&m_ActiveAnimations, &m_FrameWeights);
+		else m_FrameWeights.assign(m_Weights.size(), 0.0f);
+		if (m_FrameWeights != m_Weights) {
+			m_Weights.swap(m_FrameWeights);
+			if (m_BlendingMode == BLENDING_CPU) uploadDeformedVertices();
+			else uploadWeights();
+		}
 
 		for (auto i : m_RenderGroupUtility.renderGroups()) {
-			
+			GLShader* pShader = nullptr;
 			switch (pRDev->activePass()) {
-			case RenderDevice::RENDERPASS_GEOMETRY: {
-				if (nullptr == i->pShaderGeometryPass) continue;
-
-				pRDev->activeShader(i->pShaderGeometryPass);
-				pRDev->activeMaterial(&i->Material);
-				int32_t MTTex = i->pShaderGeometryPass->uniformLocation(GLShader::DEFAULTTEX_MORPHTARGETDATA);
-				if (MTTex >= 0) {
-					glActiveTexture(GL_TEXTURE0 + MTTex);
-					glBindTexture(GL_TEXTURE_2D, m_MorphTargetTexture);
-					glUniform1i(MTTex, MTTex);
-				}
-				uint32_t MTUBO = i->pShaderGeometryPass->uboBindingPoint(GLShader::DEFAULTUBO_MORPHTARGETDATA);
-				if (MTUBO != GL_INVALID_INDEX)m_MorphTargetUBO.bind(MTUBO);
-			}break;
-			case RenderDevice::RENDERPASS_SHADOW: {
-				if (nullptr == i->pShaderShadowPass) continue;
-
-				pRDev->activeShader(i->pShaderShadowPass);
-				pRDev->activeMaterial(&i->Material);
-				int32_t MTTex = i->pShaderShadowPass->uniformLocation(GLShader::DEFAULTTEX_MORPHTARGETDATA);
-				if (MTTex >= 0) {
-					glActiveTexture(GL_TEXTURE0 + MTTex);
-					glBindTexture(GL_TEXTURE_2D, m_MorphTargetTexture);
-					glUniform1i(MTTex, MTTex);
-				}
-				uint32_t MTUBO = i->pShaderShadowPass->uboBindingPoint(GLShader::DEFAULTUBO_MORPHTARGETDATA);
-				if (MTUBO != GL_INVALID_INDEX) m_MorphTargetUBO.bind(MTUBO);
-			}break;
-			case RenderDevice::RENDERPASS_FORWARD: {
-				if (nullptr == i->pShaderForwardPass) continue;
-
-				pRDev->activeShader(i->pShaderForwardPass);
-				pRDev->activeMaterial(&i->Material);
-				int32_t MTTex = i->pShaderForwardPass->uniformLocation(GLShader::DEFAULTTEX_MORPHTARGETDATA);
-				if (MTTex >= 0) {
-					glActiveTexture(GL_TEXTURE0 + MTTex);
-					glBindTexture(GL_TEXTURE_2D, m_MorphTargetTexture);
-					glUniform1i(MTTex, MTTex);
-				}
-				uint32_t MTUBO = i->pShaderForwardPass->uboBindingPoint(GLShader::DEFAULTUBO_MORPHTARGETDATA);
-				if(MTUBO != GL_INVALID_INDEX) m_MorphTargetUBO.bind(MTUBO);
-			}break;
+			case RenderDevice::RENDERPASS_GEOMETRY: pShader = i->pShaderGeometryPass; break;
+			case RenderDevice::RENDERPASS_SHADOW: pShader = i->pShaderShadowPass; break;
+			case RenderDevice::RENDERPASS_FORWARD: pShader = i->pShaderForwardPass; break;
 			default: continue;
 			}//switch[active pass]
+			if (nullptr == pShader) continue;
+
+			pRDev->activeShader(pShader);
+			pRDev->activeMaterial(&i->Material);
+			if (m_BlendingMode == BLENDING_VERTEXSHADER) bindMorphTargetData(pShader);
 
 			m_VertexArray.bind();
 			glDrawRangeElements(GL_TRIANGLES, 0, m_ElementBuffer.size() / sizeof(unsigned int), i->Range.y() - i->Range.x(), GL_UNSIGNED_INT, (const void*)(i->Range.x() * sizeof(unsigned int)));
@@ -143,46 +138,140 @@ namespace CForge {
 
 	}//update
 
-	void MorphTargetActor::buildMorphTargetBuffer(T3DMesh<float>* pMesh) {
+	void MorphTargetActor::buildMorphTargetBuffer(T3DMesh<float>* pMesh, bool HalfFloatDeltas) {
 		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
 		if (pMesh->morphTargetCount() == 0) throw CForgeExcept("Mesh contains no morph targets. Can not build morph target buffer.");
-		
-		float* pBufferData = nullptr;
-		uint32_t ElementCount = 0;
 
-		// one set of vertices for each morph target
-		ElementCount = pMesh->morphTargetCount() * (pMesh->vertexCount() * 3);
-		pBufferData = new float[ElementCount];
-		// initialize with 0
-		CForgeUtility::memset(pBufferData, 0.0f, ElementCount);
+		const uint32_t VertexCount = pMesh->vertexCount();
+		const uint32_t MorphTargetCount = pMesh->morphTargetCount();
 
-		for (uint32_t i = 0; i < pMesh->morphTargetCount(); ++i) {
-			T3DMesh<float>::MorphTarget* pMT = pMesh->getMorphTarget(i);
+		int32_t MaxTextureSize = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &MaxTextureSize);
+		m_TextureWidth = std::min(uint32_t(4096), uint32_t(MaxTextureSize));
+		m_MorphTargetCount = MorphTargetCount;
 
+		// count entries per vertex
+		std::vector<int32_t> Index(VertexCount * 2, 0);
+		for (uint32_t i = 0; i < MorphTargetCount; ++i) {
+			T3DMesh<float>::MorphTarget* pMT = pMesh->getMorphTarget(i);
+			for (auto k : pMT->VertexIDs) {
+				if (k >= VertexCount) throw IndexOutOfBoundsExcept("Morph target vertex ID");
+				Index[k * 2 + 1]++;
+			}//for[vertex IDs]
+		}//for[morph targets]
+
+		// first entry of each vertex
+		uint32_t EntryCount = 0;
+		for (uint32_t i = 0; i < VertexCount; ++i) {
+			Index[i * 2 + 0] = EntryCount;
+			EntryCount += Index[i * 2 + 1];
+		}//for[vertices]
+
+		// displacement (xyz) and morph target ID (w) of each entry, data is padded to whole texture rows
+		const uint32_t DataRows = (std::max(EntryCount, uint32_t(1)) + m_TextureWidth - 1) / m_TextureWidth;
+		const uint32_t IndexRows = (VertexCount + m_TextureWidth - 1) / m_TextureWidth;
+		const uint32_t WeightRows = (MorphTargetCount + m_TextureWidth - 1) / m_TextureWidth;
+		if (DataRows > uint32_t(MaxTextureSize) || IndexRows > uint32_t(MaxTextureSize)) throw CForgeExcept("Morph target data exceeds the maximum texture size!");
+
+		std::vector<float> Data(size_t(DataRows) * m_TextureWidth * 4, 0.0f);
+		std::vector<int32_t> Cursor(VertexCount);
+		for (uint32_t i = 0; i < VertexCount; ++i) Cursor[i] = Index[i * 2 + 0];
+		for (uint32_t i = 0; i < MorphTargetCount; ++i) {
+			T3DMesh<float>::MorphTarget* pMT = pMesh->getMorphTarget(i);
 			for (uint32_t k = 0; k < pMT->VertexIDs.size(); ++k) {
 				const Vector3f Displ = pMT->VertexOffsets[k];
-				const uint32_t ID = pMT->VertexIDs[k];
-				const uint32_t Index = i * (pMesh->vertexCount() * 3) + (ID * 3);
-
-				pBufferData[Index + 0] = Displ[0];
-				pBufferData[Index + 1] = Displ[1];
-				pBufferData[Index + 2] = Displ[2];
-
+				float* pEntry = &Data[size_t(Cursor[pMT->VertexIDs[k]]++) * 4];
+				pEntry[0] = Displ[0];
+				pEntry[1] = Displ[1];
+				pEntry[2] = Displ[2];
+				pEntry[3] = float(i);
 			}//for[vertexIDs]
-		}
+		}//for[morph targets]
+		Index.resize(size_t(IndexRows) * m_TextureWidth * 2, 0);
 
-		glGenTextures(1, &m_MorphTargetTexture);
-		glBindTexture(GL_TEXTURE_2D, m_MorphTargetTexture);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, pMesh->vertexCount(), pMesh->morphTargetCount(), 0, GL_RGB, GL_FLOAT, pBufferData);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		// half floats represent the morph target ID exactly up to 2048
+		if (HalfFloatDeltas && MorphTargetCount > 2048) {
+			SLogger::log("Half float morph target deltas support at most 2048 morph targets. Using floats instead.", "MorphTargetActor", SLogger::LOGTYPE_WARNING);
+			HalfFloatDeltas = false;
+		}
 
+		createDataTexture(&m_MorphTargetTexture, (HalfFloatDeltas) ? GL_RGBA16F : GL_RGBA32F, GL_RGBA, GL_FLOAT, DataRows, Data.data());
+		createDataTexture(&m_MorphTargetIndexTexture, GL_RG32I, GL_RG_INTEGER, GL_INT, IndexRows, Index.data());
+		createDataTexture(&m_MorphTargetWeightTexture, GL_R32F, GL_RED, GL_FLOAT, WeightRows, nullptr);
 
-		// clean up
-		delete[] pBufferData;
-		pBufferData = nullptr;
+		m_Weights.clear();
+		m_FrameWeights.clear();
+		uploadWeights();
 	}//buildMorphTargetBuffer
 
+	void MorphTargetActor::createDataTexture(uint32_t* pTexture, int32_t InternalFormat, uint32_t Format, uint32_t Type, uint32_t Rows, const void* pData) {
+		glGenTextures(1, pTexture);
+		glBindTexture(GL_TEXTURE_2D, *pTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, m_TextureWidth, Rows, 0, Format, Type, pData);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}//createDataTexture
+
+	void MorphTargetActor::uploadWeights(void) {
+		if (!glIsTexture(m_MorphTargetWeightTexture)) return;
+
+		// weights missing in m_Weights are zero
+		const uint32_t RowCount = (m_MorphTargetCount + m_TextureWidth - 1) / m_TextureWidth;
+		std::vector<float> Rows(size_t(RowCount) * m_TextureWidth, 0.0f);
+		std::copy_n(m_Weights.begin(), std::min(m_Weights.size(), size_t(m_MorphTargetCount)), Rows.begin());
+		glBindTexture(GL_TEXTURE_2D, m_MorphTargetWeightTexture);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_TextureWidth, RowCount, GL_RED, GL_FLOAT, Rows.data());
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}//uploadWeights
+
+	void MorphTargetActor::bindMorphTargetData(GLShader* pShader) {
+		const GLShader::DefaultTex Textures[3] = { GLShader::DEFAULTTEX_MORPHTARGETDATA, GLShader::DEFAULTTEX_MORPHTARGETINDEX, GLShader::DEFAULTTEX_MORPHTARGETWEIGHTS };
+		const uint32_t TextureHandles[3] = { m_MorphTargetTexture, m_MorphTargetIndexTexture, m_MorphTargetWeightTexture };
+		for (uint8_t i = 0; i < 3; ++i) {
+			const int32_t Loc = pShader->uniformLocation(Textures[i]);
+			if (Loc < 0) continue;
+			glActiveTexture(GL_TEXTURE0 + Loc);
+			glBindTexture(GL_TEXTURE_2D, TextureHandles[i]);
+			glUniform1i(Loc, Loc);
+		}//for[morph target textures]
+
+		const uint32_t MTUBO = pShader->uboBindingPoint(GLShader::DEFAULTUBO_MORPHTARGETDATA);
+		if (MTUBO != GL_INVALID_INDEX) m_MorphTargetUBO.bind(MTUBO);
+	}//bindMorphTargetData
+
+	void MorphTargetActor::initDeformedBuffer(T3DMesh<float>* pMesh) {
+		m_Blending.init(pMesh);
+
+		// positions and normals as vec4, so blended data is uploaded without repacking
+		const uint32_t VertexCount = m_Blending.vertexCount();
+		const uint32_t ArraySize = VertexCount * sizeof(Vector4f);
+		const bool Normals = m_Blending.hasNormals() && m_VertexUtility.hasProperties(VertexUtility::VPROP_NORMAL);
+		m_DeformedBuffer.init(GLBuffer::BTYPE_VERTEX, GLBuffer::BUSAGE_DYNAMIC_DRAW, nullptr, (Normals) ? 2 * ArraySize : ArraySize);
+		m_DeformedBuffer.bufferSubData(0, ArraySize, m_Blending.positions());
+		if (Normals) m_DeformedBuffer.bufferSubData(ArraySize, ArraySize, m_Blending.normals());
+
+		// replace position and normal attributes of the static buffer (vertex array has to be bound)
+		m_DeformedBuffer.bind();
+		glVertexAttribPointer(GLShader::attribArrayIndex(GLShader::ATTRIB_POSITION), 3, GL_FLOAT, GL_FALSE, sizeof(Vector4f), (const void*)0);
+		if (Normals) glVertexAttribPointer(GLShader::attribArrayIndex(GLShader::ATTRIB_NORMAL), 3, GL_FLOAT, GL_FALSE, sizeof(Vector4f), (const void*)(uint64_t(ArraySize)));
+	}//initDeformedBuffer
+
+	void MorphTargetActor::uploadDeformedVertices(void) {
+		m_Blending.blend(m_Weights.data(), uint32_t(m_Weights.size()));
+
+		uint32_t Begin = 0;
+		uint32_t End = 0;
+		m_Blending.changedRange(&Begin, &End);
+		if (Begin >= End) return;
+
+		const uint32_t ArraySize = m_Blending.vertexCount() * sizeof(Vector4f);
+		const uint32_t Offset = Begin * sizeof(Vector4f);
+		const uint32_t Payload = (End - Begin) * sizeof(Vector4f);
+		m_DeformedBuffer.bufferSubData(Offset, Payload, &m_Blending.positions()[Begin]);
+		if (m_DeformedBuffer.size() > ArraySize) m_DeformedBuffer.bufferSubData(ArraySize + Offset, Payload, &m_Blending.normals()[Begin]);
+	}//uploadDeformedVertices
+
 	int32_t MorphTargetActor::addAnimation(MorphTargetAnimationController::ActiveAnimation* pAnim) {
 		if (nullptr == pAnim) throw NullpointerExcept("pAnim");
 		int32_t Rval = -1;
@@ -22,14 +22,36 @@
 #include "../GLBuffer.h"
 #include "../UniformBufferObjects/UBOMorphTargetData.h"
 #include "../Controller/MorphTargetAnimationController.h"
+#include "../../MeshProcessing/CPUMorphTargetBlending.h"
 
 namespace CForge {
+	/**
+	* \brief Actor deforming a mesh by weighted morph targets.
+	*
+	* By default the weights get blended once per frame on the CPU (CPUMorphTargetBlending) into a dynamic position/normal buffer that all render passes draw from. Alternatively the vertex shader of every pass blends the targets.
+	*
+	* In both modes morph targets are stored sparse: for every vertex only the displacements of the morph targets that move it are kept. Memory scales with the number of displaced vertices instead of vertexCount times morph target count. All data textures wrap at a fixed width, so large meshes do not exceed the maximum texture width.
+	*
+	* \todo Do full documentation.
+	*/
 	class CFORGE_API MorphTargetActor : public IRenderableActor {
 	public:
+		enum BlendingMode : int8_t {
+			BLENDING_CPU = 0,		///< Blend once per frame into a vertex buffer
+			BLENDING_VERTEXSHADER,	///< Blend in the vertex shader of every render pass
+		};
+
 		MorphTargetActor(void);
 		~MorphTargetActor(void);
 
-		void init(T3DMesh<float>* pMesh, MorphTargetAnimationController *pController);
+		/**
+		* \brief Initialization method.
+		* \param[in] pMesh Mesh with morph targets.
+		* \param[in] pController Morph target animation controller initialized with the same mesh.
+		* \param[in] Mode Where the morph targets get blended.
+		* \param[in] HalfFloatDeltas Store displacements as half floats, which halves the memory of the displacement texture. Vertex shader blending only. Requires at most 2048 morph targets, falls back to floats otherwise.
+		*/
+		void init(T3DMesh<float>* pMesh, MorphTargetAnimationController *pController, BlendingMode Mode = BLENDING_CPU, bool HalfFloatDeltas = false);
 		void clear(void);
 		void release(void);
 
@@ -39,9 +61,25 @@ namespace CForge {
 		int32_t addAnimation(MorphTargetAnimationController::ActiveAnimation* pAnim);
 
 	protected:
-		void buildMorphTargetBuffer(T3DMesh<float>* pMesh);
+		void buildMorphTargetBuffer(T3DMesh<float>* pMesh, bool HalfFloatDeltas);
+		void createDataTexture(uint32_t* pTexture, int32_t InternalFormat, uint32_t Format, uint32_t Type, uint32_t Rows, const void* pData);
+		void uploadWeights(void);
+		void bindMorphTargetData(GLShader* pShader);
+		void initDeformedBuffer(T3DMesh<float>* pMesh);
+		void uploadDeformedVertices(void);
+
+		BlendingMode m_BlendingMode;
+		CPUMorphTargetBlending m_Blending;
+		GLBuffer m_DeformedBuffer; ///< Blended positions followed by blended normals, 4 floats each
+
+		uint32_t m_MorphTargetTexture; ///< Sparse displacements and morph target IDs, grouped by vertex
+		uint32_t m_MorphTargetIndexTexture; ///< First entry and entry count of each vertex
+		uint32_t m_MorphTargetWeightTexture; ///< Weight of each morph target
+		uint32_t m_TextureWidth; ///< Width at which the entries of all morph target textures wrap
+		uint32_t m_MorphTargetCount;
 
-		uint32_t m_MorphTargetTexture;
+		std::vector<float> m_Weights; ///< Weights of the last upload
+		std::vector<float> m_FrameWeights;
 
 		UBOMorphTargetData m_MorphTargetUBO;
 		MorphTargetAnimationController* m_pAnimationController;
@@ -6,6 +6,13 @@ namespace CForge {
 
 	RenderGroupUtility::RenderGroupUtility(void): CForgeObject("RenderGroupUtiliy") {
 		m_RenderGroups.clear();
+		m_Instancing = false;
+		m_InstancedShadersBuilt = false;
+		m_BoneCount = 0;
+		m_MorphTargetCount = 0;
+		m_VertexColors = false;
+		m_VSConfigOptions = 0;
+		m_VSDisabledOptions = 0;
 
 #ifdef SHADER_GLES
 		m_GLSLVersionTag = "300 es";
@@ -21,11 +28,14 @@ namespace CForge {
 		clear();
 	}//Destructor
 
-	void RenderGroupUtility::init(const T3DMesh<float>* pMesh, void **ppBuffer, uint32_t *pBufferSize) {
+	void RenderGroupUtility::init(const T3DMesh<float>* pMesh, void **ppBuffer, uint32_t *pBufferSize, bool Instancing, uint16_t VSConfigOptions, uint16_t VSDisabledOptions) {
 		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
 		if (pMesh->submeshCount() == 0) throw CForgeExcept("Mesh does not contain any submeshes");
 
 		clear();
+		m_Instancing = Instancing;
+		m_VSConfigOptions = VSConfigOptions;
+		m_VSDisabledOptions = VSDisabledOptions;
 
 		for (uint32_t i = 0; i < pMesh->submeshCount(); ++i) {
 			m_RenderGroups.push_back(new RenderGroup());
@@ -37,6 +47,7 @@ namespace CForge {
 	void RenderGroupUtility::clear(void) {
 		for (auto& i : m_RenderGroups) delete i;
 		m_RenderGroups.clear();
+		m_InstancedShadersBuilt = false;
 	}//clear
 
 	void RenderGroupUtility::buildIndexArray(const T3DMesh<float>* pMesh, void** ppBuffer, uint32_t* pBufferSize) {
@@ -60,6 +71,10 @@ namespace CForge {
 		if (nullptr == pBuffer) throw OutOfMemoryExcept("pBuffer");
 		uint32_t BufferPointer = 0;
 
+		m_BoneCount = pMesh->boneCount();
+		m_MorphTargetCount = pMesh->morphTargetCount();
+		m_VertexColors = (pMesh->colorCount() > 0);
+
 		// fill buffer and build render groups
 		SShaderManager* pSMan = SShaderManager::instance();
 		for (uint32_t i = 0; i < m_RenderGroups.size(); ++i) {
@@ -87,25 +102,22 @@ namespace CForge {
 				
 				const T3DMesh<float>::Material* pMat = pMesh->getMaterial(UsedMaterial);
 
-				std::vector<std::string> VSSources;
-				std::vector<std::string> FSSources;
+				pRG->NormalMapping = (pMesh->tangentCount() > 0 && !pMat->TexNormal.empty());
 
 				// geometry pass
-				VSSources = (pMat->VertexShaderGeometryPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_VS_GEOMETRY_PASS) : pMat->VertexShaderGeometryPass;
-				FSSources = (pMat->FragmentShaderGeometryPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_FS_GEOMETRY_PASS) : pMat->FragmentShaderGeometryPass;
-				pRG->pShaderGeometryPass = (VSSources.empty() || FSSources.empty()) ? nullptr : createShader(pMesh, pMat, VSSources, FSSources);
+				pRG->VSSourcesGeometryPass = (pMat->VertexShaderGeometryPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_VS_GEOMETRY_PASS) : pMat->VertexShaderGeometryPass;
+				pRG->FSSourcesGeometryPass = (pMat->FragmentShaderGeometryPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_FS_GEOMETRY_PASS) : pMat->FragmentShaderGeometryPass;
+				pRG->pShaderGeometryPass = (pRG->VSSourcesGeometryPass.empty() || pRG->FSSourcesGeometryPass.empty()) ? nullptr : createShader(pRG->VSSourcesGeometryPass, pRG->FSSourcesGeometryPass, pRG->NormalMapping, m_VSConfigOptions);
 
 				// shadow pass
-				VSSources = (pMat->VertexShaderShadowPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_VS_SHADOW_PASS) : pMat->VertexShaderShadowPass;
-				FSSources = (pMat->FragmentShaderShadowPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_FS_SHADOW_PASS) : pMat->FragmentShaderShadowPass;
-				pRG->pShaderShadowPass = (VSSources.empty() || FSSources.empty()) ? nullptr : createShader(pMesh, pMat, VSSources, FSSources);
-
+				pRG->VSSourcesShadowPass = (pMat->VertexShaderShadowPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_VS_SHADOW_PASS) : pMat->VertexShaderShadowPass;
+				pRG->FSSourcesShadowPass = (pMat->FragmentShaderShadowPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_FS_SHADOW_PASS) : pMat->FragmentShaderShadowPass;
+				pRG->pShaderShadowPass = (pRG->VSSourcesShadowPass.empty() || pRG->FSSourcesShadowPass.empty()) ? nullptr : createShader(pRG->VSSourcesShadowPass, pRG->FSSourcesShadowPass, pRG->NormalMapping, m_VSConfigOptions);
 
 				// forward pass
-				VSSources = (pMat->VertexShaderForwardPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_VS_FORWARD_PASS) : pMat->VertexShaderForwardPass;
-				FSSources = (pMat->FragmentShaderForwardPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_FS_FORWARD_PASS) : pMat->FragmentShaderForwardPass;
-				pRG->pShaderForwardPass = (VSSources.empty() ||FSSources.empty()) ? nullptr : createShader(pMesh, pMat, VSSources, FSSources);
-				
+				pRG->VSSourcesForwardPass = (pMat->VertexShaderForwardPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_VS_FORWARD_PASS) : pMat->VertexShaderForwardPass;
+				pRG->FSSourcesForwardPass = (pMat->FragmentShaderForwardPass.empty()) ? pSMan->defaultShaderSources(SShaderManager::DEF_FS_FORWARD_PASS) : pMat->FragmentShaderForwardPass;
+				pRG->pShaderForwardPass = (pRG->VSSourcesForwardPass.empty() || pRG->FSSourcesForwardPass.empty()) ? nullptr : createShader(pRG->VSSourcesForwardPass, pRG->FSSourcesForwardPass, pRG->NormalMapping, m_VSConfigOptions);
 			}
 
 			// initialize material
@@ -126,13 +138,33 @@ namespace CForge {
 		pSMan->release();
 		pSMan = nullptr;
 
+		m_InstancedShadersBuilt = false;
+		if (m_Instancing) buildInstancedShaders();
+
 		// set return values
 		(*ppBuffer) = pBuffer;
 		(*pBufferSize) = IndexCount * sizeof(uint32_t);
 
 	}//buildIndexArray
 
-	GLShader* RenderGroupUtility::createShader(const T3DMesh<float>* pMesh, const T3DMesh<float>::Material* pMat, std::vector<std::string> VSSources, std::vector<std::string> FSSources) {
+	void RenderGroupUtility::buildInstancedShaders(void) {
+		if (m_InstancedShadersBuilt) return;
+
+		for (auto pRG : m_RenderGroups) {
+			const uint16_t ConfigOptions = m_VSConfigOptions | ShaderCode::CONF_INSTANCING;
+			if (!pRG->VSSourcesGeometryPass.empty() && !pRG->FSSourcesGeometryPass.empty()) pRG->pShaderGeometryPassInstanced = createShader(pRG->VSSourcesGeometryPass, pRG->FSSourcesGeometryPass, pRG->NormalMapping, ConfigOptions);
+			if (!pRG->VSSourcesShadowPass.empty() && !pRG->FSSourcesShadowPass.empty()) pRG->pShaderShadowPassInstanced = createShader(pRG->VSSourcesShadowPass, pRG->FSSourcesShadowPass, pRG->NormalMapping, ConfigOptions);
+			if (!pRG->VSSourcesForwardPass.empty() && !pRG->FSSourcesForwardPass.empty()) pRG->pShaderForwardPassInstanced = createShader(pRG->VSSourcesForwardPass, pRG->FSSourcesForwardPass, pRG->NormalMapping, ConfigOptions);
+		}//for[render groups]
+
+		m_InstancedShadersBuilt = true;
+	}//buildInstancedShaders
+
+	bool RenderGroupUtility::instancedShadersBuilt(void)const {
+		return m_InstancedShadersBuilt;
+	}//instancedShadersBuilt
+
+	GLShader* RenderGroupUtility::createShader(const std::vector<std::string>& VSSources, const std::vector<std::string>& FSSources, bool NormalMapping, uint16_t VSConfigOptions) {
 		GLShader* pRval = nullptr;
 
 		SShaderManager* pSMan = SShaderManager::instance();
@@ -142,23 +174,27 @@ namespace CForge {
 		try {
 
 			for (auto k : VSSources) {
-				uint8_t ConfigOptions = 0;
+				uint16_t ConfigOptions = VSConfigOptions;
+				// baked vertex animation and palette skinning replace the default skinning and morphing
+				const bool VertexAnimation = (VSConfigOptions & (ShaderCode::CONF_VERTEXANIMATION | ShaderCode::CONF_SKINNINGPALETTES));
+				const bool SkeletalAnimation = (m_BoneCount > 0 && !VertexAnimation && !(m_VSDisabledOptions & ShaderCode::CONF_SKELETALANIMATION));
+				const bool MorphTargetAnimation = (m_MorphTargetCount > 0 && !VertexAnimation && !(m_VSDisabledOptions & ShaderCode::CONF_MORPHTARGETANIMATION));
 
 				// requires skeletal animation?
-				if (pMesh->boneCount() > 0) {
+				if (SkeletalAnimation) {
 					ConfigOptions |= ShaderCode::CONF_SKELETALANIMATION;
 				}
 				// requires morph target animation?
-				if (pMesh->morphTargetCount() > 0) {
+				if (MorphTargetAnimation) {
 					ConfigOptions |= ShaderCode::CONF_MORPHTARGETANIMATION;
 				}
 				// requires per vertex colors
-				if (pMesh->colorCount() > 0) {
+				if (m_VertexColors) {
 					ConfigOptions |= ShaderCode::CONF_VERTEXCOLORS;
 				}
 
 				//requires normal mapping
-				if (pMesh->tangentCount() > 0 && !pMat->TexNormal.empty()) {
+				if (NormalMapping) {
 					ConfigOptions |= ShaderCode::CONF_NORMALMAPPING;
 				}
 
@@ -170,13 +206,13 @@ namespace CForge {
 
 				ShaderCode* pC = pSMan->createShaderCode(k, m_GLSLVersionTag, ConfigOptions, m_GLSLPrecisionTag);
 
-				if (pMesh->boneCount() > 0) {
+				if (SkeletalAnimation) {
 					ShaderCode::SkeletalAnimationConfig SKConfig;
-					SKConfig.BoneCount = pMesh->boneCount();
+					SKConfig.BoneCount = m_BoneCount;
 					pC->config(&SKConfig);
 				}
 
-				if (pMesh->morphTargetCount() > 0) {
+				if (MorphTargetAnimation) {
 					ShaderCode::MorphTargetAnimationConfig MTConfig;
 
 					pC->config(&MTConfig);
@@ -186,12 +222,12 @@ namespace CForge {
 			}
 
 			for (auto k : FSSources) {
-				uint8_t ConfigOptions = 0;
+				uint16_t ConfigOptions = 0;
 
-				if (pMesh->colorCount() > 0) {
+				if (m_VertexColors) {
 					ConfigOptions |= ShaderCode::CONF_VERTEXCOLORS;
 				}
-				if (pMesh->tangentCount() > 0 && !pMat->TexNormal.empty()) {
+				if (NormalMapping) {
 					ConfigOptions |= ShaderCode::CONF_NORMALMAPPING;
 				}
 
@@ -41,38 +41,77 @@ namespace CForge {
 			GLShader *pShaderGeometryPass;
 			GLShader* pShaderShadowPass;
 			GLShader* pShaderForwardPass;
+			// shader variants reading per instance attributes (built on demand, see buildInstancedShaders)
+			GLShader* pShaderGeometryPassInstanced;
+			GLShader* pShaderShadowPassInstanced;
+			GLShader* pShaderForwardPassInstanced;
+			// resolved shader sources, kept to build the instanced variants later
+			std::vector<std::string> VSSourcesGeometryPass;
+			std::vector<std::string> FSSourcesGeometryPass;
+			std::vector<std::string> VSSourcesShadowPass;
+			std::vector<std::string> FSSourcesShadowPass;
+			std::vector<std::string> VSSourcesForwardPass;
+			std::vector<std::string> FSSourcesForwardPass;
+			bool NormalMapping;
 
 			RenderGroup(void) {
 				pShaderGeometryPass = nullptr;
 				pShaderShadowPass = nullptr;
 				pShaderForwardPass = nullptr;
+				pShaderGeometryPassInstanced = nullptr;
+				pShaderShadowPassInstanced = nullptr;
+				pShaderForwardPassInstanced = nullptr;
+				NormalMapping = false;
 			}
 
 			~RenderGroup(void) {
 				pShaderGeometryPass = nullptr;
 				pShaderShadowPass = nullptr;
 				pShaderForwardPass = nullptr;
+				pShaderGeometryPassInstanced = nullptr;
+				pShaderShadowPassInstanced = nullptr;
+				pShaderForwardPassInstanced = nullptr;
 			}
 		};//RenderGroup
 
 		RenderGroupUtility(void);
 		~RenderGroupUtility(void);
 
-		void init(const T3DMesh<float>* pMesh, void** ppBuffer = nullptr, uint32_t* pBufferSize = nullptr);
+		/**
+		* \brief Initialization. Builds the index array and shaders if buffer pointers are specified.
+		* \param[in] Instancing Build the instanced shader variants right away. Otherwise they are built on the first call of buildInstancedShaders.
+		* \param[in] VSConfigOptions Additional shader configuration options for all vertex shaders (ShaderCode::ConfigOptions). Baked vertex animation and palette skinning replace skeletal and morph target animation.
+		* \param[in] VSDisabledOptions Options that are not derived from the mesh, e.g. CONF_MORPHTARGETANIMATION if the actor deforms the vertices itself.
+		*/
+		void init(const T3DMesh<float>* pMesh, void** ppBuffer = nullptr, uint32_t* pBufferSize = nullptr, bool Instancing = false, uint16_t VSConfigOptions = 0, uint16_t VSDisabledOptions = 0);
 		void clear(void);
 		void buildIndexArray(const T3DMesh<float>* pMesh, void** ppBuffer, uint32_t* pBufferSize);
 
+		/**
+		* \brief Builds the instanced shader variants of all render groups. Does nothing if they were already built. Requires a valid OpenGL context.
+		*/
+		void buildInstancedShaders(void);
+		bool instancedShadersBuilt(void)const;
+
 		std::vector<RenderGroup*> renderGroups(void);
 		const RenderGroup* renderGroup(uint32_t Index)const;
 		uint32_t renderGroupCount(void)const;
 
 	protected:
-		GLShader* createShader(const T3DMesh<float>* pMesh, const T3DMesh<float>::Material *pMat, std::vector<std::string> VSSources, std::vector<std::string> FSSources);
+		GLShader* createShader(const std::vector<std::string>& VSSources, const std::vector<std::string>& FSSources, bool NormalMapping, uint16_t VSConfigOptions = 0);
 
 	private:
 		std::vector<RenderGroup*> m_RenderGroups;
 		std::string m_GLSLVersionTag;
 		std::string m_GLSLPrecisionTag;
+		bool m_Instancing;
+		bool m_InstancedShadersBuilt;
+		// mesh properties that configure the shaders
+		uint32_t m_BoneCount;
+		uint32_t m_MorphTargetCount;
+		bool m_VertexColors;
+		uint16_t m_VSConfigOptions;
+		uint16_t m_VSDisabledOptions;
 	};//RenderGroupUtility
 
 }//name space
@@ -8,6 +8,11 @@ namespace CForge {
 	SkeletalActor::SkeletalActor(void): IRenderableActor("SkeletalActor", ATYPE_SKELETAL) {
 		m_pAnimationController = nullptr;
 		m_pActiveAnimation = nullptr;
+		m_ScreenSize = 1.0f;
+		m_SkinnedAABBVersion = 0;
+		m_pSkinnedAABBAnimation = nullptr;
+		m_SkinnedAABBTime = 0.0f;
+		m_SkinnedAABBValid = false;
 	}//Constructor
 
 	SkeletalActor::~SkeletalActor(void) {
@@ -53,11 +58,16 @@ namespace CForge {
 
 		m_pAnimationController = pController;
 		m_BV.init(pMesh, BoundingVolume::TYPE_AABB);
+		VertexUtility::buildBoneInfluenceSpheres(pMesh, &m_BoneInfluences);
 	}//initialize
 
 	void SkeletalActor::clear(void) {
 		m_pAnimationController = nullptr;
 		m_pActiveAnimation = nullptr;
+		m_BoneInfluences.clear();
+		m_pSkinnedAABBAnimation = nullptr;
+		m_SkinnedAABBTime = 0.0f;
+		m_SkinnedAABBValid = false;
 	}//clear
 
 	void SkeletalActor::release(void) {
@@ -72,9 +82,12 @@ namespace CForge {
 			m_pActiveAnimation = nullptr;
 		}
 		
+		if (m_LOD.Enabled) updateLOD(pRDev, Rotation, Translation, Scale);
+
 		// set current animation data 
 		// if active animation is nullptr bind pose will be set
 		m_pAnimationController->applyAnimation(m_pActiveAnimation, true);
+		updateSkinnedBounds();
 
 		
 		for (auto i : m_RenderGroupUtility.renderGroups()) {
@@ -125,4 +138,84 @@ namespace CForge {
 		return m_pActiveAnimation;
 	}//activeAnimation
 
+	SkeletalAnimationController* SkeletalActor::animationController(void)const {
+		return m_pAnimationController;
+	}//animationController
+
+	BoundingVolume SkeletalActor::boundingVolume(void)const {
+		if (!m_SkinnedAABBValid) return m_BV;
+
+		BoundingVolume Rval;
+		const bool Current = (m_pSkinnedAABBAnimation == m_pActiveAnimation && (nullptr == m_pActiveAnimation || m_pActiveAnimation->t == m_SkinnedAABBTime));
+		if (Current || m_BV.type() != BoundingVolume::TYPE_AABB) {
+			Rval.init(m_SkinnedAABB);
+		}
+		else {
+			// pose of the current animation time was not evaluated yet
+			const Box BindPose = m_BV.aabb();
+			Box Merged;
+			Merged.init(BindPose.min().cwiseMin(m_SkinnedAABB.min()), BindPose.max().cwiseMax(m_SkinnedAABB.max()));
+			Rval.init(Merged);
+		}
+		return Rval;
+	}//boundingVolume
+
+	void SkeletalActor::updateSkinnedBounds(void) {
+		if (nullptr == m_pAnimationController || m_BoneInfluences.empty() || m_BoneInfluences.size() != m_pAnimationController->jointCount()) return;
+		// pose did not change since the last update (e.g. further render passes)
+		if (m_SkinnedAABBValid && m_SkinnedAABBVersion == m_pAnimationController->poseVersion()) {
+			m_pSkinnedAABBAnimation = m_pActiveAnimation;
+			m_SkinnedAABBTime = (nullptr == m_pActiveAnimation) ? 0.0f : m_pActiveAnimation->t;
+			return;
+		}
+
+		const Eigen::AlignedBox3f Bounds = VertexUtility::skinnedBounds(&m_BoneInfluences, m_pAnimationController->skinningMatrices());
+		if (Bounds.isEmpty()) return;
+		m_SkinnedAABB.init(Bounds.min(), Bounds.max());
+		m_SkinnedAABBVersion = m_pAnimationController->poseVersion();
+		m_pSkinnedAABBAnimation = m_pActiveAnimation;
+		m_SkinnedAABBTime = (nullptr == m_pActiveAnimation) ? 0.0f : m_pActiveAnimation->t;
+		m_SkinnedAABBValid = true;
+	}//updateSkinnedBounds
+
+	bool SkeletalActor::dynamicBoundingVolume(void)const {
+		return (nullptr != m_pAnimationController);
+	}//dynamicBoundingVolume
+
+	void SkeletalActor::animationLOD(const AnimationLOD LOD) {
+		m_LOD = LOD;
+		if (!m_LOD.Enabled && nullptr != m_pAnimationController && nullptr != m_pActiveAnimation) m_pAnimationController->lod(m_pActiveAnimation, 0.0f, false);
+	}//animationLOD
+
+	SkeletalActor::AnimationLOD SkeletalActor::animationLOD(void)const {
+		return m_LOD;
+	}//animationLOD
+
+	float SkeletalActor::screenSize(void)const {
+		return m_ScreenSize;
+	}//screenSize
+
+	void SkeletalActor::updateLOD(RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale) {
+		// measure in the camera pass, other passes (e.g. shadow) use the light's camera
+		const VirtualCamera* pCam = pRDev->activeCamera();
+		if (pRDev->activePass() == RenderDevice::RENDERPASS_GEOMETRY && nullptr != pCam && pCam->fieldOfView() > 0.0f && m_BV.type() != BoundingVolume::TYPE_UNKNOWN) {
+			const Sphere BS = m_BV.boundingSphere();
+			const Eigen::Vector3f Center = Translation + Rotation * Scale.cwiseProduct(BS.center());
+			const float Radius = BS.radius() * Scale.cwiseAbs().maxCoeff();
+			const float Distance = (Center - pCam->position()).norm();
+			m_ScreenSize = (Distance > Radius) ? Radius / (Distance * std::tan(pCam->fieldOfView() * 0.5f)) : 1.0f;
+		}
+
+		if (nullptr == m_pActiveAnimation) return;
+
+		// discrete levels, so key poses of the animation stay valid while the size changes slightly
+		float TimeStep = 0.0f;
+		if (m_ScreenSize <= m_LOD.MinScreenSize) TimeStep = m_LOD.MaxTimeStep;
+		else if (m_ScreenSize < m_LOD.FullRateScreenSize) {
+			const float Level = (m_LOD.FullRateScreenSize - m_ScreenSize) / (m_LOD.FullRateScreenSize - m_LOD.MinScreenSize);
+			TimeStep = (Level > 0.5f) ? m_LOD.MaxTimeStep * 0.5f : m_LOD.MaxTimeStep * 0.25f;
+		}
+		m_pAnimationController->lod(m_pActiveAnimation, TimeStep, m_ScreenSize < m_LOD.LeafSkipScreenSize);
+	}//updateLOD
+
 }//name-space
\ No newline at end of file
@@ -22,23 +22,74 @@
 #include "../Controller/SkeletalAnimationController.h"
 
 namespace CForge {
+	/**
+	* \brief Actor for skinned meshes animated by a SkeletalAnimationController.
+	*
+	* With animation level of detail enabled, the actor measures its projected size during the geometry pass and picks the time step of its active animation (and whether leaf joints get skipped) for the following evaluations. The level is stored with the animation, so actors sharing a controller do not interfere.
+	*
+	* \todo Do full documentation.
+	*/
 	class CFORGE_API SkeletalActor : public IRenderableActor {
 	public:
+		struct AnimationLOD {
+			bool Enabled;
+			float FullRateScreenSize;	///< Projected height (fraction of the viewport height) from which on the animation runs at full rate
+			float MinScreenSize;		///< Projected height at and below which MaxTimeStep is used
+			float MaxTimeStep;			///< Seconds between two evaluated poses for the smallest actors. Steps in between are MaxTimeStep/4 and MaxTimeStep/2.
+			float LeafSkipScreenSize;	///< Below this projected height leaf joints are not animated
+
+			AnimationLOD(void) {
+				Enabled = false;
+				FullRateScreenSize = 0.25f;
+				MinScreenSize = 0.05f;
+				MaxTimeStep = 0.1f;
+				LeafSkipScreenSize = 0.1f;
+			}
+		};
+
 		SkeletalActor(void);
 		~SkeletalActor(void);
 
 		virtual void init(T3DMesh<float>* pMesh, SkeletalAnimationController* pController);
 		virtual void activeAnimation(SkeletalAnimationController::Animation* pAnim);
 		virtual SkeletalAnimationController::Animation* activeAnimation(void)const;
+		SkeletalAnimationController* animationController(void)const;
+
+		void animationLOD(const AnimationLOD LOD);
+		AnimationLOD animationLOD(void)const;
+		float screenSize(void)const; ///< Projected height measured during the last geometry pass.
 		virtual void clear(void);
 		virtual void release(void);
 
 		virtual void render(class RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale);
 
+		/**
+		* \brief Axis aligned box of the last evaluated pose, see updateSkinnedBounds. Bind pose volume until a pose was evaluated or if no bone data is available. If the active animation moved on since the box was built (e.g. the actor got culled and was not rendered), the bind pose volume merged with the last box is returned, so the actor does not stay culled by an outdated pose.
+		*/
+		virtual BoundingVolume boundingVolume(void)const;
+		virtual bool dynamicBoundingVolume(void)const;
+
+		/**
+		* \brief Builds the box of the current pose from per bone influence spheres (bind space) transformed by the skinning matrices, so no vertex has to be skinned on the CPU. Call right after the controller evaluated the actor's pose (render and SkeletalAnimationSystem do).
+		*/
+		void updateSkinnedBounds(void);
+
 	protected:
+		void updateLOD(class RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale);
+
 		SkeletalAnimationController* m_pAnimationController;
 		SkeletalAnimationController::Animation* m_pActiveAnimation;
 
+		AnimationLOD m_LOD;
+		float m_ScreenSize;
+
+		std::vector<Eigen::Vector4f> m_BoneInfluences; ///< Per bone influence spheres, see VertexUtility::buildBoneInfluenceSpheres
+		Box m_SkinnedAABB;
+		uint32_t m_SkinnedAABBVersion;
+		const SkeletalAnimationController::Animation* m_pSkinnedAABBAnimation; ///< Animation and time the box was built for
+		float m_SkinnedAABBTime;
+		bool m_SkinnedAABBValid;
+
 	};//SkeletalActor
 
 }//name-space
@@ -0,0 +1,235 @@
+#include "../OpenGLHeader.h"
+#include "../RenderDevice.h"
+#include "SkeletalCrowdActor.h"
+#include "../../Core/SLogger.h"
+#include "../../Utility/CForgeUtility.h"
+
+using namespace Eigen;
+
+namespace CForge {
+
+	SkeletalCrowdActor::SkeletalCrowdActor(void): IRenderableActor("SkeletalCrowdActor", ATYPE_SKELETALCROWD) {
+		m_TypeID = ATYPE_SKELETALCROWD;
+		m_TypeName = "Skeletal Crowd Actor";
+		m_pAnimationController = nullptr;
+		m_Bounds.setEmpty();
+		m_BoundsDirty = false;
+	}//Constructor
+
+	SkeletalCrowdActor::~SkeletalCrowdActor(void) {
+		clear();
+	}//Destructor
+
+	void SkeletalCrowdActor::init(T3DMesh<float>* pMesh, SkeletalAnimationController* pController) {
+		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
+		if (nullptr == pController) throw NullpointerExcept("pController");
+		if (pMesh->vertexCount() == 0) throw CForgeExcept("Mesh contains no vertex data. Can not initialize!");
+		if (pMesh->boneCount() == 0) throw CForgeExcept("Mesh contains no bones. Can not initialize!");
+
+		clear();
+
+		uint16_t VProps = VertexUtility::VPROP_POSITION | VertexUtility::VPROP_BONEINDICES | VertexUtility::VPROP_BONEWEIGHTS;
+		if (pMesh->normalCount() > 0) VProps |= VertexUtility::VPROP_NORMAL;
+		if (pMesh->tangentCount() > 0) VProps |= VertexUtility::VPROP_TANGENT;
+		if (pMesh->textureCoordinatesCount() > 0) VProps |= VertexUtility::VPROP_UVW;
+
+		uint8_t* pBuffer = nullptr;
+		uint32_t BufferSize = 0;
+
+		m_VertexArray.init();
+		m_VertexArray.bind();
+
+		m_VertexUtility.init(VProps);
+		m_VertexUtility.buildBuffer(pMesh->vertexCount(), (void**)&pBuffer, &BufferSize, pMesh);
+		m_VertexBuffer.init(GLBuffer::BTYPE_VERTEX, GLBuffer::BUSAGE_STATIC_DRAW, pBuffer, BufferSize);
+		if (nullptr != pBuffer) delete[] pBuffer;
+		pBuffer = nullptr;
+		BufferSize = 0;
+
+		// palettes are always indexed by instance, so only the instanced shaders are used
+		m_RenderGroupUtility.init(pMesh, (void**)&pBuffer, &BufferSize, true, ShaderCode::CONF_SKINNINGPALETTES);
+		m_ElementBuffer.init(GLBuffer::BTYPE_INDEX, GLBuffer::BUSAGE_STATIC_DRAW, pBuffer, BufferSize);
+		if (nullptr != pBuffer) delete[] pBuffer;
+		pBuffer = nullptr;
+		BufferSize = 0;
+
+		setBufferData();
+		initInstanceBuffer();
+		m_VertexArray.unbind();
+
+		m_Palettes.init(pController->jointCount());
+		m_pAnimationController = pController;
+
+		std::string ErrorMsg;
+		if (GL_NO_ERROR != CForgeUtility::checkGLError(&ErrorMsg)) {
+			SLogger::log("Not handled OpenGL error occurred during initialization of a SkeletalCrowdActor: " + ErrorMsg, "SkeletalCrowdActor", SLogger::LOGTYPE_ERROR);
+		}
+
+		m_BV.init(pMesh, BoundingVolume::TYPE_AABB);
+		m_MeshAABB = m_BV.aabb();
+		VertexUtility::buildBoneInfluenceSpheres(pMesh, &m_BoneInfluences);
+	}//initialize
+
+	void SkeletalCrowdActor::clear(void) {
+		m_VertexBuffer.clear();
+		m_ElementBuffer.clear();
+		m_InstanceBuffer.clear();
+		m_Instances.clear();
+		m_InstanceAnimations.clear();
+		m_InstancePoses.clear();
+		m_isInstanced = false;
+		m_isManualInstaned = false;
+		m_VertexArray.clear();
+
+		m_VertexUtility.clear();
+		m_RenderGroupUtility.clear();
+		m_Palettes.clear();
+		m_pAnimationController = nullptr;
+		m_BoneInfluences.clear();
+		m_Bounds.setEmpty();
+		m_BoundsDirty = false;
+	}//clear
+
+	void SkeletalCrowdActor::release(void) {
+		delete this;
+	}//release
+
+	void SkeletalCrowdActor::render(RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale) {
+		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
+		if (m_Instances.empty()) return;
+
+		if (m_InstancesChanged) {
+			instanceData(m_Instances.data(), m_Instances.size());
+			m_InstancesChanged = false;
+		}
+		updatePalettes();
+		if (m_BoundsDirty) updateBoundingVolume();
+
+		m_VertexArray.bind();
+		for (uint32_t i = 0; i < m_RenderGroupUtility.renderGroupCount(); ++i) {
+			GLShader* pShader = renderGroupShader(pRDev, i, true);
+			if (nullptr == pShader) continue;
+			pRDev->activeShader(pShader);
+			pRDev->activeMaterial(material(i));
+			m_Palettes.bind(pShader);
+
+			const RenderGroupUtility::RenderGroup* pGroup = m_RenderGroupUtility.renderGroup(i);
+			glDrawElementsInstanced(GL_TRIANGLES, (pGroup->Range.y() - pGroup->Range.x()), GL_UNSIGNED_INT, (const void*)(pGroup->Range.x() * sizeof(unsigned int)), m_Instances.size());
+		}//for[all render groups]
+		m_VertexArray.unbind();
+	}//render
+
+	void SkeletalCrowdActor::addInstance(Eigen::Matrix4f Matrix) {
+		addInstance(Matrix, nullptr);
+	}//addInstance
+
+	uint32_t SkeletalCrowdActor::addInstance(Eigen::Matrix4f Matrix, SkeletalAnimationController::Animation* pAnim) {
+		InstancePose Pose;
+		Pose.AnimationID = -1;
+		Pose.t = 0.0f;
+		Pose.Valid = false;
+		Pose.Bounds = AlignedBox3f(m_MeshAABB.min(), m_MeshAABB.max());
+
+		// instances may have been cleared in the meantime
+		m_InstanceAnimations.resize(m_Instances.size(), nullptr);
+		m_InstancePoses.resize(m_Instances.size(), Pose);
+
+		IRenderableActor::addInstance(Matrix);
+		m_InstanceAnimations.push_back(pAnim);
+		m_InstancePoses.push_back(Pose);
+
+		// pose is not known yet, bind pose bounds until the next frame rebuilds them
+		extendBoundingVolume(Matrix, Pose.Bounds);
+		return uint32_t(m_Instances.size() - 1);
+	}//addInstance
+
+	void SkeletalCrowdActor::instanceTransformation(uint32_t Index, Eigen::Matrix4f Matrix) {
+		if (Index >= m_Instances.size()) throw IndexOutOfBoundsExcept("Index");
+		m_Instances[Index] = Matrix;
+		m_InstancesChanged = true;
+		if (Index < m_InstancePoses.size()) extendBoundingVolume(Matrix, m_InstancePoses[Index].Bounds);
+	}//instanceTransformation
+
+	void SkeletalCrowdActor::instanceAnimation(uint32_t Index, SkeletalAnimationController::Animation* pAnim) {
+		if (Index >= m_InstanceAnimations.size()) throw IndexOutOfBoundsExcept("Index");
+		m_InstanceAnimations[Index] = pAnim;
+	}//instanceAnimation
+
+	SkeletalAnimationController::Animation* SkeletalCrowdActor::instanceAnimation(uint32_t Index)const {
+		if (Index >= m_InstanceAnimations.size()) throw IndexOutOfBoundsExcept("Index");
+		return m_InstanceAnimations[Index];
+	}//instanceAnimation
+
+	SkeletalAnimationController* SkeletalCrowdActor::animationController(void)const {
+		return m_pAnimationController;
+	}//animationController
+
+	bool SkeletalCrowdActor::dynamicBoundingVolume(void)const {
+		return true;
+	}//dynamicBoundingVolume
+
+	void SkeletalCrowdActor::updatePalettes(void) {
+		m_InstanceAnimations.resize(m_Instances.size(), nullptr);
+		if (m_InstancePoses.size() != m_Instances.size()) {
+			InstancePose Pose;
+			Pose.AnimationID = -1;
+			Pose.t = 0.0f;
+			Pose.Valid = false;
+			Pose.Bounds = AlignedBox3f(m_MeshAABB.min(), m_MeshAABB.max());
+			m_InstancePoses.resize(m_Instances.size(), Pose);
+			m_BoundsDirty = true;
+		}
+		if (m_Palettes.paletteCount() != m_Instances.size()) m_Palettes.paletteCount(m_Instances.size());
+
+		// further render passes of the same frame find all poses unchanged
+		for (uint32_t i = 0; i < m_Instances.size(); ++i) {
+			SkeletalAnimationController::Animation* pAnim = m_InstanceAnimations[i];
+			const int32_t AnimationID = (nullptr == pAnim) ? -1 : pAnim->AnimationID;
+			const float t = (nullptr == pAnim) ? 0.0f : pAnim->t;
+			InstancePose* pPose = &m_InstancePoses[i];
+			if (pPose->Valid && pPose->AnimationID == AnimationID && pPose->t == t) continue;
+
+			m_pAnimationController->evaluatePose(pAnim);
+			m_Palettes.palette(i, m_pAnimationController->skinningMatrices());
+			// evaluation may clamp the time
+			pPose->AnimationID = AnimationID;
+			pPose->t = (nullptr == pAnim) ? 0.0f : pAnim->t;
+			pPose->Valid = true;
+			if (m_BoneInfluences.size() == m_pAnimationController->jointCount()) {
+				const AlignedBox3f Bounds = VertexUtility::skinnedBounds(&m_BoneInfluences, m_pAnimationController->skinningMatrices());
+				if (!Bounds.isEmpty()) pPose->Bounds = Bounds;
+			}
+			m_BoundsDirty = true;
+		}//for[instances]
+
+		m_Palettes.upload();
+	}//updatePalettes
+
+	void SkeletalCrowdActor::updateBoundingVolume(void) {
+		// pose bounds of all instances
+		m_Bounds.setEmpty();
+		const uint32_t Count = uint32_t(std::min(m_Instances.size(), m_InstancePoses.size()));
+		for (uint32_t i = 0; i < Count; ++i) {
+			const Affine3f T(m_Instances[i]);
+			for (uint32_t k = 0; k < 8; ++k) m_Bounds.extend(T * m_InstancePoses[i].Bounds.corner(AlignedBox3f::CornerType(k)));
+		}//for[instances]
+		m_BoundsDirty = false;
+
+		if (m_Bounds.isEmpty()) return;
+		Box AABB;
+		AABB.init(m_Bounds.min(), m_Bounds.max());
+		m_BV.init(AABB);
+	}//updateBoundingVolume
+
+	void SkeletalCrowdActor::extendBoundingVolume(const Eigen::Matrix4f& Matrix, const Eigen::AlignedBox3f& Bounds) {
+		// conservative until the next rebuild, e.g. moved instances leave their old space in the box
+		const Affine3f T(Matrix);
+		for (uint32_t k = 0; k < 8; ++k) m_Bounds.extend(T * Bounds.corner(AlignedBox3f::CornerType(k)));
+		m_BoundsDirty = true;
+
+		Box AABB;
+		AABB.init(m_Bounds.min(), m_Bounds.max());
+		m_BV.init(AABB);
+	}//extendBoundingVolume
+
+}//name space
@@ -0,0 +1,88 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): SkeletalCrowdActor.h and SkeletalCrowdActor.cpp                  *
+*                                                                           *
+* Content: Draws many instances of a skinned mesh, each with its own pose, *
+*          in one instanced draw call per render group.                    *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_SKELETALCROWDACTOR_H__
+#define __CFORGE_SKELETALCROWDACTOR_H__
+
+#include "IRenderableActor.h"
+#include "SkinningPaletteTexture.h"
+#include "../Controller/SkeletalAnimationController.h"
+
+namespace CForge {
+	/**
+	* \brief Instanced skinned mesh. Every instance has a transformation (relative to the actor's transformation) and an animation of the shared controller. Skinning matrices of all instances are gathered in a SkinningPaletteTexture, the vertex shader picks the palette by instance ID. This also lifts the bone count limit of the UBO based skinning.
+	*
+	* Poses get evaluated once per frame and only for instances whose animation or animation time changed. Use a SkeletalPoseCache with the controller to share poses between instances playing the same clip.
+	*
+	* The bounding volume covers the evaluated poses of all instances (per bone influence spheres transformed by each palette). Adding or moving instances only extends it, it gets rebuilt once per frame during rendering if poses or transformations changed.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API SkeletalCrowdActor : public IRenderableActor {
+	public:
+		SkeletalCrowdActor(void);
+		~SkeletalCrowdActor(void);
+
+		void init(T3DMesh<float>* pMesh, SkeletalAnimationController* pController);
+		void clear(void);
+		void release(void);
+
+		void render(class RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale);
+
+		void addInstance(Eigen::Matrix4f Matrix);
+		/**
+		* \brief Adds an instance.
+		* \param[in] Matrix Transformation relative to the actor's transformation.
+		* \param[in] pAnim Animation of the actor's controller. nullptr shows the bind pose. Lifetime is managed by the caller.
+		* \return Index of the instance.
+		*/
+		uint32_t addInstance(Eigen::Matrix4f Matrix, SkeletalAnimationController::Animation* pAnim);
+		void instanceTransformation(uint32_t Index, Eigen::Matrix4f Matrix);
+		void instanceAnimation(uint32_t Index, SkeletalAnimationController::Animation* pAnim);
+		SkeletalAnimationController::Animation* instanceAnimation(uint32_t Index)const;
+
+		SkeletalAnimationController* animationController(void)const;
+
+		bool dynamicBoundingVolume(void)const; ///< Bounds follow the poses and transformations of the instances.
+
+	protected:
+		void updatePalettes(void);
+		void updateBoundingVolume(void);
+		void extendBoundingVolume(const Eigen::Matrix4f& Matrix, const Eigen::AlignedBox3f& Bounds);
+
+		SkeletalAnimationController* m_pAnimationController;
+		SkinningPaletteTexture m_Palettes;
+
+		struct InstancePose {
+			int32_t AnimationID; ///< -1 for bind pose
+			float t;
+			bool Valid;
+			Eigen::AlignedBox3f Bounds; ///< Bounds of the pose in mesh space
+		};
+
+		std::vector<SkeletalAnimationController::Animation*> m_InstanceAnimations;
+		std::vector<InstancePose> m_InstancePoses; ///< Pose stored in the palette of each instance
+
+		Box m_MeshAABB; ///< Bind pose bounds of the mesh
+		std::vector<Eigen::Vector4f> m_BoneInfluences; ///< Per bone influence spheres, see VertexUtility::buildBoneInfluenceSpheres
+		Eigen::AlignedBox3f m_Bounds; ///< Bounds of all instances in actor space
+		bool m_BoundsDirty; ///< Poses or transformations changed since the bounds were rebuilt
+	};//SkeletalCrowdActor
+
+}//name space
+
+#endif
@@ -0,0 +1,140 @@
+#include "../OpenGLHeader.h"
+#include "SkinningPaletteTexture.h"
+
+namespace CForge {
+
+	SkinningPaletteTexture::SkinningPaletteTexture(void): CForgeObject("SkinningPaletteTexture") {
+		m_JointCount = 0;
+		m_TextureWidth = 0;
+		m_TextureHeight = 0;
+		m_Texture = GL_INVALID_INDEX;
+		m_PaletteCount = 0;
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
+	}//Constructor
+
+	SkinningPaletteTexture::~SkinningPaletteTexture(void) {
+		clear();
+	}//Destructor
+
+	void SkinningPaletteTexture::init(uint32_t JointCount, uint32_t TextureWidth) {
+		if (JointCount == 0) throw CForgeExcept("Skinning palettes require at least one joint!");
+		if (TextureWidth == 0) throw CForgeExcept("Texture width has to be greater than zero!");
+		clear();
+
+		int32_t MaxTextureSize = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &MaxTextureSize);
+		m_TextureWidth = std::min(TextureWidth, uint32_t(MaxTextureSize));
+		m_JointCount = JointCount;
+
+		m_UBO.init();
+		m_UBO.layout(m_JointCount, m_TextureWidth);
+	}//initialize
+
+	void SkinningPaletteTexture::clear(void) {
+		if (glIsTexture(m_Texture)) glDeleteTextures(1, &m_Texture);
+		m_Texture = GL_INVALID_INDEX;
+		m_UBO.clear();
+		m_Data.clear();
+		m_JointCount = 0;
+		m_TextureWidth = 0;
+		m_TextureHeight = 0;
+		m_PaletteCount = 0;
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
+	}//clear
+
+	void SkinningPaletteTexture::paletteCount(uint32_t Count) {
+		if (0 == m_JointCount) throw NotInitializedExcept("Skinning palette texture was not initialized!");
+		const uint32_t Prev = m_PaletteCount;
+		m_PaletteCount = Count;
+		// staging memory covers whole texture rows, so rows can be uploaded directly
+		const uint64_t TexelCount = uint64_t(Count) * m_JointCount * 3;
+		const uint64_t RowCount = (TexelCount + m_TextureWidth - 1) / m_TextureWidth;
+		m_Data.resize(RowCount * m_TextureWidth * 4, 0.0f);
+		if (Count > Prev) {
+			m_DirtyBegin = (m_DirtyBegin < m_DirtyEnd) ? std::min(m_DirtyBegin, Prev) : Prev;
+			m_DirtyEnd = std::max(m_DirtyEnd, Count);
+		}
+		m_DirtyEnd = std::min(m_DirtyEnd, Count);
+	}//paletteCount
+
+	uint32_t SkinningPaletteTexture::paletteCount(void)const {
+		return m_PaletteCount;
+	}//paletteCount
+
+	uint32_t SkinningPaletteTexture::jointCount(void)const {
+		return m_JointCount;
+	}//jointCount
+
+	void SkinningPaletteTexture::palette(uint32_t Index, const Eigen::Matrix4f* pSkinningMats) {
+		if (nullptr == pSkinningMats) throw NullpointerExcept("pSkinningMats");
+		if (Index >= paletteCount()) throw IndexOutOfBoundsExcept("Index");
+
+		float* pData = &m_Data[size_t(Index) * m_JointCount * 3 * 4];
+		for (uint32_t i = 0; i < m_JointCount; ++i) {
+			for (uint32_t Row = 0; Row < 3; ++Row) {
+				for (uint32_t Col = 0; Col < 4; ++Col) pData[Col] = pSkinningMats[i](Row, Col);
+				pData += 4;
+			}//for[rows]
+		}//for[joints]
+
+		if (m_DirtyBegin >= m_DirtyEnd) {
+			m_DirtyBegin = Index;
+			m_DirtyEnd = Index + 1;
+		}
+		else {
+			m_DirtyBegin = std::min(m_DirtyBegin, Index);
+			m_DirtyEnd = std::max(m_DirtyEnd, Index + 1);
+		}
+	}//palette
+
+	void SkinningPaletteTexture::upload(void) {
+		if (m_DirtyBegin >= m_DirtyEnd || 0 == m_TextureWidth) return;
+
+		const uint32_t RowCount = uint32_t(m_Data.size() / (size_t(m_TextureWidth) * 4));
+		const float* pRows = m_Data.data();
+
+		if (!glIsTexture(m_Texture) || RowCount > m_TextureHeight) {
+			// grow geometrically, the whole data gets uploaded
+			int32_t MaxTextureSize = 0;
+			glGetIntegerv(GL_MAX_TEXTURE_SIZE, &MaxTextureSize);
+			if (RowCount > uint32_t(MaxTextureSize)) throw CForgeExcept("Skinning palettes exceed the maximum texture size!");
+			m_TextureHeight = std::min(std::max(RowCount, m_TextureHeight * 2), uint32_t(MaxTextureSize));
+
+			if (!glIsTexture(m_Texture)) glGenTextures(1, &m_Texture);
+			glBindTexture(GL_TEXTURE_2D, m_Texture);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, m_TextureWidth, m_TextureHeight, 0, GL_RGBA, GL_FLOAT, nullptr);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_TextureWidth, RowCount, GL_RGBA, GL_FLOAT, pRows);
+		}
+		else {
+			// only the rows covering the changed palettes
+			const uint32_t FirstTexel = m_DirtyBegin * m_JointCount * 3;
+			const uint32_t EndTexel = m_DirtyEnd * m_JointCount * 3;
+			const uint32_t FirstRow = FirstTexel / m_TextureWidth;
+			const uint32_t EndRow = (EndTexel + m_TextureWidth - 1) / m_TextureWidth;
+			glBindTexture(GL_TEXTURE_2D, m_Texture);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, FirstRow, m_TextureWidth, EndRow - FirstRow, GL_RGBA, GL_FLOAT, &pRows[size_t(FirstRow) * m_TextureWidth * 4]);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
+	}//upload
+
+	void SkinningPaletteTexture::bind(GLShader* pShader) {
+		if (nullptr == pShader) throw NullpointerExcept("pShader");
+
+		const int32_t TexLoc = pShader->uniformLocation(GLShader::DEFAULTTEX_SKINNINGPALETTES);
+		if (TexLoc >= 0) {
+			glActiveTexture(GL_TEXTURE0 + TexLoc);
+			glBindTexture(GL_TEXTURE_2D, m_Texture);
+			glUniform1i(TexLoc, TexLoc);
+		}
+		const uint32_t BindingPoint = pShader->uboBindingPoint(GLShader::DEFAULTUBO_SKINNINGPALETTEDATA);
+		if (GL_INVALID_INDEX != BindingPoint) m_UBO.bind(BindingPoint);
+	}//bind
+
+}//name space
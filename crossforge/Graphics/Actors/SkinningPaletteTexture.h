@@ -0,0 +1,71 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): SkinningPaletteTexture.h and SkinningPaletteTexture.cpp          *
+*                                                                           *
+* Content: Float texture holding the skinning matrices of many skeleton    *
+*          instances, indexed by instance in the vertex shader.            *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_SKINNINGPALETTETEXTURE_H__
+#define __CFORGE_SKINNINGPALETTETEXTURE_H__
+
+#include "../../Core/CForgeObject.h"
+#include "../Shader/GLShader.h"
+#include "../UniformBufferObjects/UBOSkinningPaletteData.h"
+
+namespace CForge {
+	/**
+	* \brief Stores skinning palettes (one skinning matrix per joint) of many instances in a single RGBA float texture. Each joint takes three texels (upper three rows of its matrix), palettes are stored one after another and wrap into rows of the texture width. Shaders built with ShaderCode::CONF_SKINNINGPALETTES use the palette of gl_InstanceID.
+	*
+	* Unlike UBOBoneData the number of joints is not limited by the uniform block size and does not get compiled into the shader. The texture grows with the number of palettes.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API SkinningPaletteTexture : public CForgeObject {
+	public:
+		SkinningPaletteTexture(void);
+		~SkinningPaletteTexture(void);
+
+		void init(uint32_t JointCount, uint32_t TextureWidth = 1024);
+		void clear(void);
+
+		void paletteCount(uint32_t Count);
+		uint32_t paletteCount(void)const;
+		uint32_t jointCount(void)const;
+
+		/**
+		* \brief Sets the palette of an instance. Gets uploaded by the next call to upload.
+		* \param[in] Index Instance index.
+		* \param[in] pSkinningMats JointCount skinning matrices, e.g. SkeletalAnimationController::skinningMatrices().
+		*/
+		void palette(uint32_t Index, const Eigen::Matrix4f* pSkinningMats);
+
+		void upload(void); ///< Uploads changed palettes, grows the texture if required.
+		void bind(GLShader* pShader); ///< Binds texture and layout to the shader's default locations.
+
+	protected:
+		uint32_t m_JointCount;
+		uint32_t m_TextureWidth;
+		uint32_t m_TextureHeight; ///< Allocated rows
+		uint32_t m_Texture;
+
+		uint32_t m_PaletteCount;
+		std::vector<float> m_Data; ///< RGBA texels of all palettes, padded to whole texture rows
+		uint32_t m_DirtyBegin; ///< First changed palette
+		uint32_t m_DirtyEnd; ///< One past the last changed palette
+
+		UBOSkinningPaletteData m_UBO;
+	};//SkinningPaletteTexture
+
+}//name space
+
+#endif
@@ -83,6 +83,7 @@ namespace CForge {
 		}
 		
 		setBufferData();
+		initInstanceBuffer();
 		m_VertexArray.unbind();
 
 		
@@ -91,11 +92,19 @@ namespace CForge {
 		}
 		
 		m_BV.init(pMesh, BoundingVolume::TYPE_SPHERE);
+		m_MeshBV = m_BV;
+		m_InstanceBounds.setEmpty();
 	}//initialize
 
 	void StaticActor::clear(void) {
 		m_VertexBuffer.clear();
 		m_ElementBuffer.clear(); 
+		m_InstanceBuffer.clear();
+		m_Instances.clear();
+		m_InstanceBounds.setEmpty();
+		m_MeshBV.clear();
+		m_isInstanced = false;
+		m_isManualInstaned = false;
 		m_VertexArray.clear();
 
 		m_VertexUtility.clear();
@@ -109,35 +118,106 @@ namespace CForge {
 	void StaticActor::render(RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale) {
 		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
 
-		
-		for (auto i : m_RenderGroupUtility.renderGroups()) {
-
-			switch (pRDev->activePass()) {
-			case RenderDevice::RENDERPASS_SHADOW: {
-				if (nullptr == i->pShaderShadowPass) continue;
-				pRDev->activeShader(i->pShaderShadowPass);
-				pRDev->activeMaterial(&i->Material);
-			}break;
-			case RenderDevice::RENDERPASS_GEOMETRY: {
-				if (nullptr == i->pShaderGeometryPass) continue;
-				pRDev->activeShader(i->pShaderGeometryPass);
-				pRDev->activeMaterial(&i->Material);
-			}break;
-			case RenderDevice::RENDERPASS_FORWARD: {
-				if (nullptr == i->pShaderForwardPass) continue;
-				pRDev->activeShader(i->pShaderForwardPass);
-				pRDev->activeMaterial(&i->Material);
-			}break;
-			default: {
-				// nothing to do
-			}break;
+		// manually instanced actors draw all instances relative to the given transformation
+		if (m_isManualInstaned) {
+			if (m_Instances.empty()) return;
+			if (m_InstancesChanged) {
+				instanceData(m_Instances.data(), m_Instances.size());
+				m_InstancesChanged = false;
 			}
-
 			m_VertexArray.bind();
-			glDrawElements(GL_TRIANGLES, (i->Range.y() - i->Range.x()), GL_UNSIGNED_INT, (const void*)(i->Range.x() * sizeof(unsigned int)));
+			for (uint32_t i = 0; i < m_RenderGroupUtility.renderGroupCount(); ++i) {
+				renderGroupInstanced(pRDev, i, m_Instances.size(), false);
+			}//for[all render groups]
 			m_VertexArray.unbind();
+			return;
+		}
+
+		m_VertexArray.bind();
+		for (uint32_t i = 0; i < m_RenderGroupUtility.renderGroupCount(); ++i) {
+			renderGroup(pRDev, i, false);
 		}//for[all render groups]
+		m_VertexArray.unbind();
 		
 	}//render
 
+	void StaticActor::boundingVolume(const BoundingVolume BV) {
+		IRenderableActor::boundingVolume(BV);
+		m_MeshBV = m_BV;
+		m_InstanceBounds.setEmpty();
+		for (const auto& i : m_Instances) extendInstanceBounds(i);
+	}//boundingVolume
+
+	void StaticActor::addInstance(Eigen::Matrix4f Matrix) {
+		if (m_Instances.empty()) m_InstanceBounds.setEmpty();
+		IRenderableActor::addInstance(Matrix);
+		extendInstanceBounds(Matrix);
+	}//addInstance
+
+	void StaticActor::clearInstances(void) {
+		IRenderableActor::clearInstances();
+		m_InstanceBounds.setEmpty();
+		if (m_MeshBV.type() == BoundingVolume::TYPE_UNKNOWN) m_BV.clear();
+		else if (m_MeshBV.type() == BoundingVolume::TYPE_AABB) m_BV.init(m_MeshBV.aabb());
+		else m_BV.init(m_MeshBV.boundingSphere());
+	}//clearInstances
+
+	void StaticActor::extendInstanceBounds(const Eigen::Matrix4f& Matrix) {
+		Eigen::AlignedBox3f Local;
+		if (m_MeshBV.type() == BoundingVolume::TYPE_AABB) {
+			Local = Eigen::AlignedBox3f(m_MeshBV.aabb().min(), m_MeshBV.aabb().max());
+		}
+		else if (m_MeshBV.type() == BoundingVolume::TYPE_SPHERE) {
+			const Sphere BS = m_MeshBV.boundingSphere();
+			Local = Eigen::AlignedBox3f(BS.center() - Eigen::Vector3f::Constant(BS.radius()), BS.center() + Eigen::Vector3f::Constant(BS.radius()));
+		}
+		else {
+			return;
+		}
+
+		// instances are drawn relative to the actor's transformation
+		const Eigen::Affine3f T(Matrix);
+		for (uint32_t i = 0; i < 8; ++i) m_InstanceBounds.extend(T * Local.corner(Eigen::AlignedBox3f::CornerType(i)));
+		Box AABB;
+		AABB.init(m_InstanceBounds.min(), m_InstanceBounds.max());
+		m_BV.init(AABB);
+	}//extendInstanceBounds
+
+	bool StaticActor::renderGroupsQueueable(void)const {
+		// manual instances get drawn as a whole
+		return !m_isManualInstaned;
+	}//renderGroupsQueueable
+
+	void StaticActor::renderGroup(RenderDevice* pRDev, uint32_t GroupIndex, bool BindVertexArray) {
+		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
+
+		GLShader* pShader = renderGroupShader(pRDev, GroupIndex, false);
+		if (nullptr != pShader) {
+			pRDev->activeShader(pShader);
+			pRDev->activeMaterial(material(GroupIndex));
+		}
+		else {
+			// passes with dedicated shaders skip groups without one, others render with current settings
+			const RenderDevice::RenderPass Pass = pRDev->activePass();
+			if (Pass == RenderDevice::RENDERPASS_SHADOW || Pass == RenderDevice::RENDERPASS_GEOMETRY || Pass == RenderDevice::RENDERPASS_FORWARD) return;
+		}
+
+		const RenderGroupUtility::RenderGroup* pGroup = m_RenderGroupUtility.renderGroup(GroupIndex);
+		if (BindVertexArray) m_VertexArray.bind();
+		glDrawElements(GL_TRIANGLES, (pGroup->Range.y() - pGroup->Range.x()), GL_UNSIGNED_INT, (const void*)(pGroup->Range.x() * sizeof(unsigned int)));
+	}//renderGroup
+
+	void StaticActor::renderGroupInstanced(RenderDevice* pRDev, uint32_t GroupIndex, uint32_t InstanceCount, bool BindVertexArray) {
+		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
+
+		GLShader* pShader = renderGroupShader(pRDev, GroupIndex, true);
+		if (nullptr == pShader) return;
+		pRDev->activeShader(pShader);
+		pRDev->activeMaterial(material(GroupIndex));
+
+		const RenderGroupUtility::RenderGroup* pGroup = m_RenderGroupUtility.renderGroup(GroupIndex);
+		if (BindVertexArray) m_VertexArray.bind();
+		glDrawElementsInstanced(GL_TRIANGLES, (pGroup->Range.y() - pGroup->Range.x()), GL_UNSIGNED_INT, (const void*)(pGroup->Range.x() * sizeof(unsigned int)), InstanceCount);
+	}//renderGroupInstanced
+
 }
\ No newline at end of file
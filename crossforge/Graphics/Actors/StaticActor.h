@@ -44,9 +44,23 @@ namespace CForge {
 
 		void render(RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale);
 
-		
+		bool renderGroupsQueueable(void)const;
+		void renderGroup(RenderDevice* pRDev, uint32_t GroupIndex, bool BindVertexArray);
+		void renderGroupInstanced(RenderDevice* pRDev, uint32_t GroupIndex, uint32_t InstanceCount, bool BindVertexArray);
+
+		/**
+		* \brief Sets the volume of a single instance. With manual instances the actor's volume encloses all of them.
+		*/
+		using IRenderableActor::boundingVolume;
+		void boundingVolume(const BoundingVolume BV);
+		void addInstance(Eigen::Matrix4f Matrix);
+		void clearInstances(void);
 
 	protected:
+		void extendInstanceBounds(const Eigen::Matrix4f& Matrix);
+
+		BoundingVolume m_MeshBV; ///< Volume of a single instance, unknown volumes stay unknown with instances
+		Eigen::AlignedBox3f m_InstanceBounds; ///< Bounds of all instances in actor space
 
 	private:
 
@@ -174,6 +174,8 @@ namespace CForge {
 			m_pActiveAnimation = nullptr;
 		}
 
+		if (m_LOD.Enabled) updateLOD(pRDev, Rotation, Translation, Scale);
+
 		// set current animation data 
 		// if active animation is nullptr bind pose will be set
 		m_pAnimationController->applyAnimation(m_pActiveAnimation, true);
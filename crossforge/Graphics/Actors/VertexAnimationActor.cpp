@@ -0,0 +1,264 @@
+#include "../OpenGLHeader.h"
+#include "../RenderDevice.h"
+#include "VertexAnimationActor.h"
+#include "../../Core/SLogger.h"
+#include "../../Utility/CForgeUtility.h"
+
+using namespace Eigen;
+
+namespace CForge {
+
+	VertexAnimationActor::VertexAnimationActor(void): IRenderableActor("VertexAnimationActor", ATYPE_VERTEXANIMATION) {
+		m_TypeID = ATYPE_VERTEXANIMATION;
+		m_TypeName = "Vertex Animation Actor";
+		m_AnimationTexture = GL_INVALID_INDEX;
+		m_TimeOffsetCount = 0;
+		m_Time = 0.0f;
+		m_Speed = 1.0f;
+	}//Constructor
+
+	VertexAnimationActor::~VertexAnimationActor(void) {
+		clear();
+	}//Destructor
+
+	void VertexAnimationActor::init(const T3DMesh<float>* pMesh, const VertexAnimationBaker::BakedAnimation* pAnim) {
+		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
+		if (nullptr == pAnim) throw NullpointerExcept("pAnim");
+		if (pMesh->vertexCount() == 0) throw CForgeExcept("Mesh contains no vertex data. Can not initialize!");
+		if (pAnim->FrameCount == 0 || pAnim->Data.size() != size_t(pAnim->TextureWidth) * pAnim->TextureHeight * 4) throw CForgeExcept("Baked animation contains no valid data!");
+		if (pAnim->Mode == VertexAnimationBaker::BAKE_VERTICES && pAnim->ElementCount != pMesh->vertexCount()) throw CForgeExcept("Baked animation does not match the mesh's vertex count!");
+		if (pAnim->Mode == VertexAnimationBaker::BAKE_SKINNINGMATRICES && pMesh->boneCount() == 0) throw CForgeExcept("Mesh contains no bones. Can not play back baked skinning matrices!");
+
+		int32_t MaxTextureSize = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &MaxTextureSize);
+		if (int32_t(pAnim->TextureWidth) > MaxTextureSize || int32_t(pAnim->TextureHeight) > MaxTextureSize) throw CForgeExcept("Baked animation exceeds the maximum texture size of " + std::to_string(MaxTextureSize) + "!");
+
+		clear();
+
+		// baked skinning matrices are applied in the shader, positions replace the vertex data
+		uint16_t VProps = VertexUtility::VPROP_POSITION;
+		if (pMesh->normalCount() > 0) VProps |= VertexUtility::VPROP_NORMAL;
+		if (pMesh->tangentCount() > 0) VProps |= VertexUtility::VPROP_TANGENT;
+		if (pMesh->textureCoordinatesCount() > 0) VProps |= VertexUtility::VPROP_UVW;
+		if (pMesh->colorCount() > 0) VProps |= VertexUtility::VPROP_COLOR;
+		if (pAnim->Mode == VertexAnimationBaker::BAKE_SKINNINGMATRICES) VProps |= VertexUtility::VPROP_BONEINDICES | VertexUtility::VPROP_BONEWEIGHTS;
+
+		uint8_t* pBuffer = nullptr;
+		uint32_t BufferSize = 0;
+
+		m_VertexArray.init();
+		m_VertexArray.bind();
+
+		m_VertexUtility.init(VProps);
+		m_VertexUtility.buildBuffer(pMesh->vertexCount(), (void**)&pBuffer, &BufferSize, pMesh);
+		m_VertexBuffer.init(GLBuffer::BTYPE_VERTEX, GLBuffer::BUSAGE_STATIC_DRAW, pBuffer, BufferSize);
+		if (nullptr != pBuffer) delete[] pBuffer;
+		pBuffer = nullptr;
+		BufferSize = 0;
+
+		m_RenderGroupUtility.init(pMesh, (void**)&pBuffer, &BufferSize, true, ShaderCode::CONF_VERTEXANIMATION);
+		m_ElementBuffer.init(GLBuffer::BTYPE_INDEX, GLBuffer::BUSAGE_STATIC_DRAW, pBuffer, BufferSize);
+		if (nullptr != pBuffer) delete[] pBuffer;
+		pBuffer = nullptr;
+		BufferSize = 0;
+
+		setBufferData();
+		initInstanceBuffer();
+
+		// per instance time offsets
+		const uint32_t TimeOffsetLoc = GLShader::attribArrayIndex(GLShader::ATTRIB_INSTANCE_TIMEOFFSET);
+		m_TimeOffsetBuffer.init(GLBuffer::BTYPE_VERTEX, GLBuffer::BUSAGE_DYNAMIC_DRAW);
+		m_TimeOffsetBuffer.bind();
+		glEnableVertexAttribArray(TimeOffsetLoc);
+		glVertexAttribPointer(TimeOffsetLoc, 1, GL_FLOAT, GL_FALSE, sizeof(float), nullptr);
+		glVertexAttribDivisor(TimeOffsetLoc, 1);
+		m_TimeOffsetBuffer.unbind();
+		timeOffsetData(1);
+
+		m_VertexArray.unbind();
+
+		// baked data
+		glGenTextures(1, &m_AnimationTexture);
+		glBindTexture(GL_TEXTURE_2D, m_AnimationTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, pAnim->TextureWidth, pAnim->TextureHeight, 0, GL_RGBA, GL_FLOAT, pAnim->Data.data());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		m_AnimationUBO.init();
+		m_AnimationUBO.layout(pAnim->Mode, pAnim->FrameCount, pAnim->ElementCount, pAnim->TextureWidth);
+		m_AnimationUBO.timing(pAnim->TimeStep, pAnim->Duration);
+		m_AnimationUBO.time(m_Time);
+
+		std::string ErrorMsg;
+		if (GL_NO_ERROR != CForgeUtility::checkGLError(&ErrorMsg)) {
+			SLogger::log("Not handled OpenGL error occurred during initialization of a VertexAnimationActor: " + ErrorMsg, "VertexAnimationActor", SLogger::LOGTYPE_ERROR);
+		}
+
+		// bounds cover all frames
+		if (pAnim->Bounds.isEmpty()) m_BV.init(pMesh, BoundingVolume::TYPE_AABB);
+		else {
+			Box AABB;
+			AABB.init(pAnim->Bounds.min(), pAnim->Bounds.max());
+			m_BV.init(AABB);
+		}
+		m_ClipBounds = AlignedBox3f(m_BV.aabb().min(), m_BV.aabb().max());
+		m_InstanceBounds.setEmpty();
+	}//initialize
+
+	void VertexAnimationActor::clear(void) {
+		m_VertexBuffer.clear();
+		m_ElementBuffer.clear();
+		m_InstanceBuffer.clear();
+		m_TimeOffsetBuffer.clear();
+		m_Instances.clear();
+		m_InstanceTimeOffsets.clear();
+		m_TimeOffsetCount = 0;
+		m_isInstanced = false;
+		m_isManualInstaned = false;
+		m_VertexArray.clear();
+
+		m_VertexUtility.clear();
+		m_RenderGroupUtility.clear();
+		m_AnimationUBO.clear();
+		if (glIsTexture(m_AnimationTexture)) glDeleteTextures(1, &m_AnimationTexture);
+		m_AnimationTexture = GL_INVALID_INDEX;
+	}//clear
+
+	void VertexAnimationActor::release(void) {
+		delete this;
+	}//release
+
+	void VertexAnimationActor::render(RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale) {
+		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
+
+		// manually instanced actors draw all instances relative to the given transformation
+		if (m_isManualInstaned) {
+			if (m_Instances.empty()) return;
+			if (m_InstancesChanged) {
+				instanceData(m_Instances.data(), m_Instances.size());
+				timeOffsetData(m_Instances.size());
+				m_InstancesChanged = false;
+			}
+			m_VertexArray.bind();
+			for (uint32_t i = 0; i < m_RenderGroupUtility.renderGroupCount(); ++i) {
+				renderGroupInstanced(pRDev, i, m_Instances.size(), false);
+			}//for[all render groups]
+			m_VertexArray.unbind();
+			return;
+		}
+
+		m_VertexArray.bind();
+		for (uint32_t i = 0; i < m_RenderGroupUtility.renderGroupCount(); ++i) {
+			renderGroup(pRDev, i, false);
+		}//for[all render groups]
+		m_VertexArray.unbind();
+	}//render
+
+	void VertexAnimationActor::update(float FPSScale) {
+		time(m_Time + FPSScale * m_Speed);
+	}//update
+
+	void VertexAnimationActor::time(float t) {
+		m_Time = t;
+		m_AnimationUBO.time(m_Time);
+	}//time
+
+	float VertexAnimationActor::time(void)const {
+		return m_Time;
+	}//time
+
+	void VertexAnimationActor::speed(float Speed) {
+		m_Speed = Speed;
+	}//speed
+
+	float VertexAnimationActor::speed(void)const {
+		return m_Speed;
+	}//speed
+
+	void VertexAnimationActor::addInstance(Eigen::Matrix4f Matrix) {
+		addInstance(Matrix, 0.0f);
+	}//addInstance
+
+	void VertexAnimationActor::addInstance(Eigen::Matrix4f Matrix, float TimeOffset) {
+		// instances may have been cleared in the meantime
+		if (m_Instances.empty()) m_InstanceBounds.setEmpty();
+		m_InstanceTimeOffsets.resize(m_Instances.size(), 0.0f);
+		IRenderableActor::addInstance(Matrix);
+		m_InstanceTimeOffsets.push_back(TimeOffset);
+
+		// instances are drawn relative to the actor's transformation
+		const Affine3f T(Matrix);
+		for (uint32_t i = 0; i < 8; ++i) m_InstanceBounds.extend(T * m_ClipBounds.corner(AlignedBox3f::CornerType(i)));
+		Box AABB;
+		AABB.init(m_InstanceBounds.min(), m_InstanceBounds.max());
+		m_BV.init(AABB);
+	}//addInstance
+
+	void VertexAnimationActor::clearInstances(void) {
+		IRenderableActor::clearInstances();
+		m_InstanceTimeOffsets.clear();
+		m_InstanceBounds.setEmpty();
+		// back to the bounds of a single clip
+		if (m_ClipBounds.isEmpty()) return;
+		Box AABB;
+		AABB.init(m_ClipBounds.min(), m_ClipBounds.max());
+		m_BV.init(AABB);
+	}//clearInstances
+
+	bool VertexAnimationActor::renderGroupsQueueable(void)const {
+		// manual instances get drawn as a whole
+		return !m_isManualInstaned;
+	}//renderGroupsQueueable
+
+	void VertexAnimationActor::renderGroup(RenderDevice* pRDev, uint32_t GroupIndex, bool BindVertexArray) {
+		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
+
+		GLShader* pShader = renderGroupShader(pRDev, GroupIndex, false);
+		if (nullptr == pShader) return;
+		pRDev->activeShader(pShader);
+		pRDev->activeMaterial(material(GroupIndex));
+		bindAnimationData(pShader);
+
+		const RenderGroupUtility::RenderGroup* pGroup = m_RenderGroupUtility.renderGroup(GroupIndex);
+		if (BindVertexArray) m_VertexArray.bind();
+		glDrawElements(GL_TRIANGLES, (pGroup->Range.y() - pGroup->Range.x()), GL_UNSIGNED_INT, (const void*)(pGroup->Range.x() * sizeof(unsigned int)));
+	}//renderGroup
+
+	void VertexAnimationActor::renderGroupInstanced(RenderDevice* pRDev, uint32_t GroupIndex, uint32_t InstanceCount, bool BindVertexArray) {
+		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
+
+		GLShader* pShader = renderGroupShader(pRDev, GroupIndex, true);
+		if (nullptr == pShader) return;
+		pRDev->activeShader(pShader);
+		pRDev->activeMaterial(material(GroupIndex));
+		bindAnimationData(pShader);
+
+		// draws coalesced by the render queue may have more instances than offsets
+		if (InstanceCount > m_TimeOffsetCount) timeOffsetData(InstanceCount);
+
+		const RenderGroupUtility::RenderGroup* pGroup = m_RenderGroupUtility.renderGroup(GroupIndex);
+		if (BindVertexArray) m_VertexArray.bind();
+		glDrawElementsInstanced(GL_TRIANGLES, (pGroup->Range.y() - pGroup->Range.x()), GL_UNSIGNED_INT, (const void*)(pGroup->Range.x() * sizeof(unsigned int)), InstanceCount);
+	}//renderGroupInstanced
+
+	void VertexAnimationActor::bindAnimationData(GLShader* pShader) {
+		const int32_t TexLoc = pShader->uniformLocation(GLShader::DEFAULTTEX_VERTEXANIMATIONDATA);
+		if (TexLoc >= 0) {
+			glActiveTexture(GL_TEXTURE0 + TexLoc);
+			glBindTexture(GL_TEXTURE_2D, m_AnimationTexture);
+			glUniform1i(TexLoc, TexLoc);
+		}
+		const uint32_t BindingPoint = pShader->uboBindingPoint(GLShader::DEFAULTUBO_VERTEXANIMATIONDATA);
+		if (GL_INVALID_INDEX != BindingPoint) m_AnimationUBO.bind(BindingPoint);
+	}//bindAnimationData
+
+	void VertexAnimationActor::timeOffsetData(uint32_t InstanceCount) {
+		m_InstanceTimeOffsets.resize(m_Instances.size(), 0.0f);
+		m_TimeOffsetData.assign(std::max(InstanceCount, uint32_t(m_InstanceTimeOffsets.size())), 0.0f);
+		std::copy(m_InstanceTimeOffsets.begin(), m_InstanceTimeOffsets.end(), m_TimeOffsetData.begin());
+		m_TimeOffsetBuffer.bufferData(m_TimeOffsetData.data(), m_TimeOffsetData.size() * sizeof(float));
+		m_TimeOffsetCount = uint32_t(m_TimeOffsetData.size());
+	}//timeOffsetData
+
+}//name space
@@ -0,0 +1,89 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): VertexAnimationActor.h and VertexAnimationActor.cpp              *
+*                                                                           *
+* Content: Actor playing back baked vertex animations entirely in the       *
+*          vertex shader.                                                   *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_VERTEXANIMATIONACTOR_H__
+#define __CFORGE_VERTEXANIMATIONACTOR_H__
+
+#include "IRenderableActor.h"
+#include "../GLBuffer.h"
+#include "../UniformBufferObjects/UBOVertexAnimationData.h"
+#include "../Controller/VertexAnimationBaker.h"
+
+namespace CForge {
+	/**
+	* \brief Plays back an animation baked by VertexAnimationBaker. The baked data lives in a float texture, the vertex shader fetches and interpolates the two frames around the current time. No CPU work per frame besides advancing the playback time, so crowds are drawn with a single instanced draw call per render group.
+	*
+	* Every instance can have its own time offset, so instances do not move in lockstep. Clips loop. With instances the bounding volume covers the clip's bounds under every instance transformation.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API VertexAnimationActor : public IRenderableActor {
+	public:
+		VertexAnimationActor(void);
+		~VertexAnimationActor(void);
+
+		/**
+		* \brief Initialization.
+		* \param[in] pMesh Mesh the animation was baked from.
+		* \param[in] pAnim Baked animation. Data gets copied to the GPU, so it can be released afterwards.
+		*/
+		void init(const T3DMesh<float>* pMesh, const VertexAnimationBaker::BakedAnimation* pAnim);
+		void clear(void);
+		void release(void);
+
+		void render(class RenderDevice* pRDev, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale);
+
+		/**
+		* \brief Advances the playback time. Same time scale as SkeletalAnimationController::update.
+		*/
+		void update(float FPSScale);
+
+		void time(float t);
+		float time(void)const;
+		void speed(float Speed);
+		float speed(void)const;
+
+		void addInstance(Eigen::Matrix4f Matrix);
+		void addInstance(Eigen::Matrix4f Matrix, float TimeOffset);
+		void clearInstances(void);
+
+		bool renderGroupsQueueable(void)const;
+		void renderGroup(class RenderDevice* pRDev, uint32_t GroupIndex, bool BindVertexArray);
+		void renderGroupInstanced(class RenderDevice* pRDev, uint32_t GroupIndex, uint32_t InstanceCount, bool BindVertexArray);
+
+	protected:
+		void bindAnimationData(GLShader* pShader);
+		void timeOffsetData(uint32_t InstanceCount); ///< Uploads the time offsets of the manual instances, padded with zeros to at least InstanceCount entries
+
+		uint32_t m_AnimationTexture;
+		UBOVertexAnimationData m_AnimationUBO;
+
+		GLBuffer m_TimeOffsetBuffer; ///< per instance time offsets
+		uint32_t m_TimeOffsetCount; ///< Number of entries in the time offset buffer
+		std::vector<float> m_InstanceTimeOffsets; ///< Time offsets of the manual instances
+		std::vector<float> m_TimeOffsetData; ///< Staging memory for the time offset buffer
+
+		float m_Time;
+		float m_Speed;
+
+		Eigen::AlignedBox3f m_ClipBounds; ///< Bounds of the mesh over all frames
+		Eigen::AlignedBox3f m_InstanceBounds; ///< Bounds of all instances in actor space
+	};//VertexAnimationActor
+
+}//name space
+
+#endif
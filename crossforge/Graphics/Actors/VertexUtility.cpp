@@ -97,7 +97,7 @@ namespace CForge {
 		return m_VertexSize;
 	}//vertexSize
 
-	void buildSkeletonAssignment(const T3DMesh<float>* pMesh, vector<Vector4i>* pBoneIndices, vector<Vector4f>* pSkinningWeights) {
+	void VertexUtility::buildSkeletonAssignment(const T3DMesh<float>* pMesh, vector<Vector4i>* pBoneIndices, vector<Vector4f>* pSkinningWeights) {
 		if (pMesh->boneCount() == 0) return; // nothing to do here
 		if (nullptr == pBoneIndices) throw NullpointerExcept("pBoneIndices");
 		if (nullptr == pSkinningWeights) throw NullpointerExcept("pSkinningWeights");
@@ -139,6 +139,54 @@ namespace CForge {
 
 	}//buildSkeletonAssignment
 
+	void VertexUtility::buildBoneInfluenceSpheres(const T3DMesh<float>* pMesh, vector<Vector4f>* pSpheres) {
+		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
+		if (nullptr == pSpheres) throw NullpointerExcept("pSpheres");
+		pSpheres->assign(pMesh->boneCount(), Vector4f(0.0f, 0.0f, 0.0f, -1.0f));
+
+		for (uint32_t i = 0; i < pMesh->boneCount(); ++i) {
+			const T3DMesh<float>::Bone* pBone = pMesh->getBone(i);
+			if (pBone->ID < 0 || pBone->ID >= int32_t(pSpheres->size())) continue;
+
+			// center of the influenced vertices
+			Vector3f Center = Vector3f::Zero();
+			uint32_t Count = 0;
+			for (uint32_t k = 0; k < pBone->VertexInfluences.size(); ++k) {
+				if (k < pBone->VertexWeights.size() && pBone->VertexWeights[k] <= 0.0f) continue;
+				Center += pMesh->vertex(pBone->VertexInfluences[k]);
+				Count++;
+			}
+			if (0 == Count) continue;
+			Center /= float(Count);
+
+			float Radius = 0.0f;
+			for (uint32_t k = 0; k < pBone->VertexInfluences.size(); ++k) {
+				if (k < pBone->VertexWeights.size() && pBone->VertexWeights[k] <= 0.0f) continue;
+				Radius = std::max(Radius, (pMesh->vertex(pBone->VertexInfluences[k]) - Center).norm());
+			}
+			pSpheres->at(pBone->ID) = Vector4f(Center.x(), Center.y(), Center.z(), Radius);
+		}//for[bones]
+	}//buildBoneInfluenceSpheres
+
+	AlignedBox3f VertexUtility::skinnedBounds(const vector<Vector4f>* pSpheres, const Matrix4f* pSkinningMats) {
+		if (nullptr == pSpheres) throw NullpointerExcept("pSpheres");
+		if (nullptr == pSkinningMats) throw NullpointerExcept("pSkinningMats");
+
+		AlignedBox3f Rval;
+		Rval.setEmpty();
+		for (uint32_t i = 0; i < pSpheres->size(); ++i) {
+			const Vector4f& BS = pSpheres->at(i);
+			if (BS.w() < 0.0f) continue;
+			const Matrix4f& M = pSkinningMats[i];
+			const Vector3f Center = M.block<3, 3>(0, 0) * BS.head<3>() + M.block<3, 1>(0, 3);
+			// largest axis scaling of the skinning matrix
+			const float Radius = BS.w() * M.block<3, 3>(0, 0).colwise().norm().maxCoeff();
+			Rval.extend(Center - Vector3f::Constant(Radius));
+			Rval.extend(Center + Vector3f::Constant(Radius));
+		}//for[bones]
+		return Rval;
+	}//skinnedBounds
+
 	void VertexUtility::buildBuffer(uint32_t VertexCount, void** ppBuffer, uint32_t* pBufferSize, const T3DMesh<float>* pMesh) {
 		if (nullptr == ppBuffer) throw NullpointerExcept("ppBuffer");
 		if (nullptr == pBufferSize) throw NullpointerExcept("pBufferSize");
@@ -53,6 +53,21 @@ namespace CForge {
 
 		void buildBuffer(uint32_t VertexCount, void** ppBuffer, uint32_t* pBufferSize, const T3DMesh<float>* pMesh = nullptr );
 
+		/**
+		* \brief Gathers up to four bone indices and weights per vertex from the mesh's bones. Unused slots get index 0 and weight 0.
+		*/
+		static void buildSkeletonAssignment(const T3DMesh<float>* pMesh, std::vector<Eigen::Vector4i>* pBoneIndices, std::vector<Eigen::Vector4f>* pSkinningWeights);
+
+		/**
+		* \brief Per bone bind space sphere (center, radius) around all vertices the bone influences. Negative radius if the bone has no influence.
+		*/
+		static void buildBoneInfluenceSpheres(const T3DMesh<float>* pMesh, std::vector<Eigen::Vector4f>* pSpheres);
+
+		/**
+		* \brief Conservative bounds of a skinned pose: the influence spheres transformed by the skinning matrices. No vertex has to be skinned. Empty box if no bone has an influence.
+		*/
+		static Eigen::AlignedBox3f skinnedBounds(const std::vector<Eigen::Vector4f>* pSpheres, const Eigen::Matrix4f* pSkinningMats);
+
 	protected:
 
 	private:
@@ -19,6 +19,31 @@ namespace CForge {
 		update();
 	}//initialize
 
+	void ViewFrustum::init(const Eigen::Matrix4f& ViewProjection) {
+		m_pCamera = nullptr;
+
+		// a point p is inside if -w <= x,y,z <= w for (x,y,z,w) = M * p
+		const Vector4f Row0 = ViewProjection.row(0);
+		const Vector4f Row1 = ViewProjection.row(1);
+		const Vector4f Row2 = ViewProjection.row(2);
+		const Vector4f Row3 = ViewProjection.row(3);
+		const Vector4f Coefficients[PLANE_COUNT] = {
+			Row3 - Row1, // top
+			Row3 + Row1, // bottom
+			Row3 - Row0, // right
+			Row3 + Row0, // left
+			Row3 - Row2, // far
+			Row3 + Row2, // near
+		};
+
+		for (int8_t i = 0; i < PLANE_COUNT; ++i) {
+			// normals point inwards, so signed distances of inside points are positive
+			const float Length = Coefficients[i].head<3>().norm();
+			if (Length <= 0.0f) throw CForgeExcept("Degenerated view projection matrix!");
+			m_Planes[i].init(-Coefficients[i].w() / Length, Vector3f(Coefficients[i].head<3>() / Length));
+		}//for[planes]
+	}//initialize
+
 	void ViewFrustum::clear(void) {
 		m_pCamera = nullptr;
 	}//clear
@@ -28,6 +53,7 @@ namespace CForge {
 	}//release
 
 	void ViewFrustum::update(void) {
+		if (nullptr == m_pCamera) return; // planes set from a matrix
 
 		const Vector3f DirMultFar = m_pCamera->farPlane() * m_pCamera->dir();
 		const Vector3f CamPos = m_pCamera->position();
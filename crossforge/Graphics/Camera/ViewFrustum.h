@@ -41,6 +41,12 @@ namespace CForge {
 		~ViewFrustum(void);
 
 		void init(class VirtualCamera* pCamera);
+
+		/**
+		* \brief Extracts the planes from a combined projection and view matrix (Gribb and Hartmann), e.g. of a shadow casting light. The frustum is not bound to a camera, update does nothing.
+		* \param[in] ViewProjection Projection matrix times view matrix, OpenGL clip space conventions.
+		*/
+		void init(const Eigen::Matrix4f& ViewProjection);
 		void clear(void);
 		void release(void);
 
@@ -8,6 +8,7 @@ using namespace std;
 namespace CForge {
 
 	MorphTargetAnimationController::MorphTargetAnimationController(void): CForgeObject("MorphTargetAnimationController") {
+		m_pClock = nullptr;
 
 	}//Constructor
 
@@ -19,6 +20,7 @@ namespace CForge {
 		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
 		if (pMesh->morphTargetCount() == 0) throw CForgeExcept("Mesh contains no morph targets. Can not create morph target animation controller!");
 		clear();
+		m_pClock = SFrameClock::instance();
 
 		// create a morph target from every defined morph target
 		for (uint32_t i = 0; i < pMesh->morphTargetCount(); ++i) {
@@ -49,6 +51,8 @@ namespace CForge {
 		m_ActiveAnimations.clear();
 		m_MorphTargets.clear();
 		m_AnimationSequences.clear();
+		if (nullptr != m_pClock) m_pClock->release();
+		m_pClock = nullptr;
 	}//clear
 
 	void MorphTargetAnimationController::release(void) {
@@ -85,13 +89,14 @@ namespace CForge {
 
 	MorphTargetAnimationController::ActiveAnimation* MorphTargetAnimationController::play(int32_t SequenceID, float Speed) {
 		if (SequenceID < 0 || SequenceID >= int32_t(m_AnimationSequences.size())) throw IndexOutOfBoundsExcept("SequenceID");
+		if (nullptr == m_pClock) throw NotInitializedExcept("Morph target animation controller was not initialized!");
 
 		ActiveAnimation* pRval = new ActiveAnimation();
 		pRval->SequenceID = SequenceID;
 		pRval->Speed = Speed;
 		pRval->t = 0.0f;
 		pRval->CurrentSquenceIndex = 0;
-		pRval->SequenceStartTimestamp = CForgeUtility::timestamp();
+		pRval->SequenceStartTimestamp = m_pClock->time();
 		pRval->Finished = false;
 
 		pRval->ID = -1;
@@ -117,15 +122,17 @@ namespace CForge {
 		if (!valid(pAnim)) return;
 		if (pAnim->Finished) return;
 		
+		// all animations share the time of the current frame
 		AnimationSequence* pSeq = m_AnimationSequences[pAnim->SequenceID];
-		float ElapsedTime = float(CForgeUtility::timestamp() - pAnim->SequenceStartTimestamp)/1000.0f;
+		const uint64_t Now = m_pClock->time();
+		float ElapsedTime = float(Now - pAnim->SequenceStartTimestamp)/1000000.0f;
 		Vector3f Params = pSeq->Parameters[pAnim->CurrentSquenceIndex];
 		pAnim->t = pAnim->Speed * ElapsedTime/Params[2];
 
 		// progress to next morph target in sequence?
 		if (pAnim->t > 1.0f) {
 			pAnim->CurrentSquenceIndex++;
-			pAnim->SequenceStartTimestamp = CForgeUtility::timestamp();
+			pAnim->SequenceStartTimestamp = Now;
 			pAnim->t = 0.0f;
 
 			// end of sequence reached?
@@ -136,12 +143,11 @@ namespace CForge {
 		
 	}//progress
 
-	void MorphTargetAnimationController::apply(std::vector<ActiveAnimation*>* pAnims, UBOMorphTargetData* pUBO) {
+	void MorphTargetAnimationController::apply(std::vector<ActiveAnimation*>* pAnims, std::vector<float>* pWeights) {
+		if (pWeights == nullptr) throw NullpointerExcept("pWeights");
+		pWeights->assign(m_MorphTargets.size(), 0.0f);
 		if (pAnims == nullptr) return;
-		if (pUBO == nullptr) throw NullpointerExcept("pUBO");
 
-
-		uint32_t ActiveMorphTargets = 0;
 		for (auto i : (*pAnims)) {
 			if (nullptr == i) continue;
 			if (!valid(i)) continue;
@@ -149,17 +155,12 @@ namespace CForge {
 
 			// retrieve current morph target
 			const int32_t MTID = m_AnimationSequences[i->SequenceID]->Targets[i->CurrentSquenceIndex];
+			if (MTID < 0 || MTID >= int32_t(pWeights->size())) continue;
 			const Vector3f Params = m_AnimationSequences[i->SequenceID]->Parameters[i->CurrentSquenceIndex];
 			const float Strength = (1.0f - i->t) * Params[0] + i->t * Params[1];
-			pUBO->setMorphTargetParam(ActiveMorphTargets, MTID, Strength);
-			ActiveMorphTargets++;
-
-			// 12 is hard coded maximum in shader
-			// if we set more than 12, shader will access invalid data23
-			if (ActiveMorphTargets >= 12) break; 
+			(*pWeights)[MTID] += Strength;
 		}//for[active animations
 
-		pUBO->activeMorphTargets(ActiveMorphTargets);
 	}//apply
 
 	bool MorphTargetAnimationController::valid(ActiveAnimation* pAnim) {	
@@ -19,7 +19,7 @@
 #define __CFORGE_MORPHTARGETANIMATIONCONTROLLER_H__
 
 #include "../../AssetIO/T3DMesh.hpp"
-#include "../UniformBufferObjects/UBOMorphTargetData.h"
+#include "../../Core/SFrameClock.h"
 
 namespace CForge {
 	class CFORGE_API MorphTargetAnimationController: public CForgeObject {
@@ -49,7 +49,7 @@ namespace CForge {
 			float t;	///< current stamp
 			int32_t SequenceID;
 			int32_t CurrentSquenceIndex;
-			uint64_t SequenceStartTimestamp;
+			uint64_t SequenceStartTimestamp; ///< SFrameClock time in microseconds
 			bool Finished;
 		};
 
@@ -64,7 +64,12 @@ namespace CForge {
 		int32_t addAnimationSequence(AnimationSequence* pSequence);
 		ActiveAnimation* play(int32_t SequenceID, float Speed);
 
-		void apply(std::vector<ActiveAnimation*>* pAnims, UBOMorphTargetData* pUBO);
+		/**
+		* \brief Computes the weight of every morph target from the active animations. Strengths of animations using the same target add up.
+		* \param[in] pAnims Active animations.
+		* \param[out] pWeights One weight per morph target, resized to morphTargetCount().
+		*/
+		void apply(std::vector<ActiveAnimation*>* pAnims, std::vector<float>* pWeights);
 		bool valid(ActiveAnimation* pAnim);
 
 		uint32_t morphTargetCount(void)const;
@@ -81,6 +86,8 @@ namespace CForge {
 		std::vector<AnimationSequence*> m_AnimationSequences;
 
 		std::vector<ActiveAnimation*> m_ActiveAnimations;
+
+		SFrameClock* m_pClock;
 	};//MorphTargetAnimationController
 }//name space
 
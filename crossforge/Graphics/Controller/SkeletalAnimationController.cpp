@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "SkeletalAnimationController.h"
 #include "../Shader/SShaderManager.h"
 #include "../../Math/CForgeMath.h"
@@ -8,10 +9,18 @@ using namespace std;
 namespace CForge {
 
 	SkeletalAnimationController::SkeletalAnimationController(void): CForgeObject("SkeletalAnimationController") {
-		m_pRoot = nullptr;
 		m_pShadowPassShader = nullptr;
 		m_pShadowPassFSCode = nullptr;
 		m_pShadowPassVSCode = nullptr;
+		m_PoseValid = false;
+		m_PoseAnimationID = -1;
+		m_PoseTime = 0.0f;
+		m_UBODirty = false;
+		m_PoseVersion = 0;
+		m_pPoseCache = nullptr;
+		m_SkeletonKey = 0;
+		m_PoseLODTimeStep = 0.0f;
+		m_PoseLODSkipLeafJoints = false;
 
 #ifdef SHADER_GLES
 		m_GLSLVersionTag = "300 es";
@@ -35,40 +44,43 @@ namespace CForge {
 		if (pMesh->boneCount() == 0) throw CForgeExcept("Mesh has no bones!");
 
 
-		// create bones and copy data
-		for (uint32_t i = 0; i < pMesh->boneCount(); ++i) {
-			const T3DMesh<float>::Bone* pRef = pMesh->getBone(i);
-		
-			Joint* pJoint = new Joint();
-			pJoint->ID = pRef->ID;
-			pJoint->Name = pRef->Name;
-			pJoint->LocalPosition = Vector3f::Zero();
-			pJoint->LocalRotation = Quaternionf::Identity();
-			pJoint->LocalScale = Vector3f::Ones();
-			pJoint->OffsetMatrix = pRef->OffsetMatrix;
-			pJoint->SkinningMatrix = Matrix4f::Identity();
-
-			m_Joints.push_back(pJoint);
-		}//for[bones]
-
-		// copy structure
-		for (uint32_t i = 0; i < pMesh->boneCount(); ++i) {
-			const T3DMesh<float>::Bone* pRef = pMesh->getBone(i);
-			Joint* pJoint = m_Joints[i];
+		const uint32_t JointCount = pMesh->boneCount();
 
-			if (pRef->pParent != nullptr) pJoint->pParent = m_Joints[pRef->pParent->ID];
-			else pJoint->pParent = nullptr;
+		// create bones and copy data (joint ID equals the bone's index)
+		m_JointNames.resize(JointCount);
+		m_JointParents.assign(JointCount, -1);
+		m_JointChildren.resize(JointCount);
+		m_OffsetMatrices.resize(JointCount);
+		m_LocalPositions.assign(JointCount, Vector3f::Zero());
+		m_LocalRotations.assign(JointCount, Quaternionf::Identity());
+		m_LocalScales.assign(JointCount, Vector3f::Ones());
+		m_GlobalTransforms.assign(JointCount, Affine3f::Identity());
+		m_SkinningMatrices.assign(JointCount, Matrix4f::Identity());
 
-			for (uint32_t k = 0; k < pRef->Children.size(); ++k) pJoint->Children.push_back(m_Joints[pRef->Children[k]->ID]);
-		}
+		for (uint32_t i = 0; i < JointCount; ++i) {
+			const T3DMesh<float>::Bone* pRef = pMesh->getBone(i);
+			m_JointNames[i] = pRef->Name;
+			m_OffsetMatrices[i] = Affine3f(pRef->OffsetMatrix);
+			if (pRef->pParent != nullptr) m_JointParents[i] = pRef->pParent->ID;
+			for (uint32_t k = 0; k < pRef->Children.size(); ++k) m_JointChildren[i].push_back(pRef->Children[k]->ID);
+		}//for[bones]
 
-		// find root bone
-		for (uint32_t i = 0; i < m_Joints.size(); ++i) {
-			if (m_Joints[i]->pParent == nullptr) {
-				m_pRoot = m_Joints[i];
-				break;
-			}
+		// topological order, breadth first starting at the root(s)
+		for (uint32_t i = 0; i < JointCount; ++i) {
+			if (m_JointParents[i] < 0) m_EvaluationOrder.push_back(i);
 		}//for[all bones]
+		for (uint32_t i = 0; i < m_EvaluationOrder.size(); ++i) {
+			for (auto k : m_JointChildren[m_EvaluationOrder[i]]) m_EvaluationOrder.push_back(k);
+		}//for[evaluation order]
+		if (m_EvaluationOrder.size() != JointCount) throw CForgeExcept("Skeleton of the mesh is not a valid hierarchy!");
+
+		// skeleton key for pose sharing
+		m_SkeletonKey = SkeletalPoseCache::hash(&JointCount, sizeof(JointCount));
+		for (uint32_t i = 0; i < JointCount; ++i) {
+			m_SkeletonKey = SkeletalPoseCache::hash(m_JointNames[i].data(), uint32_t(m_JointNames[i].size()), m_SkeletonKey);
+			m_SkeletonKey = SkeletalPoseCache::hash(&m_JointParents[i], sizeof(int32_t), m_SkeletonKey);
+			m_SkeletonKey = SkeletalPoseCache::hash(m_OffsetMatrices[i].data(), 16 * sizeof(float), m_SkeletonKey);
+		}//for[joints]
 
 		if (CopyAnimationData) {
 			for (uint32_t i = 0; i < pMesh->skeletalAnimationCount(); ++i) {
@@ -77,12 +89,10 @@ namespace CForge {
 		}//if[copy animation data]
 
 		// initialize UBO
-		m_UBO.init(m_Joints.size());
+		m_UBO.init(JointCount);
 
 
-		for (uint32_t i = 0; i < m_Joints.size(); ++i) {
-			m_UBO.skinningMatrix(i, Eigen::Matrix4f::Identity());
-		}//for[bones]
+		m_UBO.skinningMatrices(m_SkinningMatrices.data(), JointCount);
 
 		SShaderManager* pSMan = SShaderManager::instance();
 
@@ -90,7 +100,7 @@ namespace CForge {
 		m_pShadowPassVSCode = pSMan->createShaderCode("Shader/ShadowPassShader.vert", m_GLSLVersionTag, ShaderCode::CONF_SKELETALANIMATION | ShaderCode::CONF_LIGHTING, m_GLSLPrecisionTag);
 
 		ShaderCode::SkeletalAnimationConfig SkelConfig;
-		SkelConfig.BoneCount = m_Joints.size();
+		SkelConfig.BoneCount = JointCount;
 		m_pShadowPassVSCode->config(&SkelConfig);
 
 		std::vector<ShaderCode*> VSSources;
@@ -105,15 +115,28 @@ namespace CForge {
 	}//initialize
 
 	void SkeletalAnimationController::clear(void) {
-		m_pRoot = nullptr;
-		for (auto& i : m_Joints) if (nullptr != i) delete i;
 		for (auto& i : m_SkeletalAnimations) if (nullptr != i) delete i;
 		for (auto& i : m_ActiveAnimations) if (nullptr != i) delete i;
-		m_Joints.clear();
+		m_JointNames.clear();
+		m_JointParents.clear();
+		m_JointChildren.clear();
+		m_EvaluationOrder.clear();
+		m_OffsetMatrices.clear();
+		m_LocalPositions.clear();
+		m_LocalRotations.clear();
+		m_LocalScales.clear();
+		m_GlobalTransforms.clear();
+		m_SkinningMatrices.clear();
 		m_SkeletalAnimations.clear();
 		m_ActiveAnimations.clear();
+		m_SharedTimelines.clear();
+		m_CompressedTracks.clear();
+		m_ClipKeys.clear();
+		m_SkeletonKey = 0;
 
 		m_UBO.clear();
+		m_PoseValid = false;
+		m_UBODirty = false;
 
 		// instances get deleted by the Shader Manager
 		m_pShadowPassShader = nullptr;
@@ -135,6 +158,29 @@ namespace CForge {
 		pAnim->Name = pAnimation->Name;
 		pAnim->Speed = pAnimation->Speed;
 
+		// clip key for pose sharing, covers the data and how it gets stored
+		uint64_t ClipKey = SkeletalPoseCache::hash(&pAnimation->Duration, sizeof(float));
+		const float Compression[4] = { m_CompressionConfig.Enabled ? 1.0f : 0.0f, m_CompressionConfig.PositionTolerance, m_CompressionConfig.RotationTolerance, m_CompressionConfig.ScalingTolerance };
+		ClipKey = SkeletalPoseCache::hash(Compression, sizeof(Compression), ClipKey);
+		for (auto i : pAnimation->Keyframes) {
+			ClipKey = SkeletalPoseCache::hash(i->BoneName.data(), uint32_t(i->BoneName.size()), ClipKey);
+			ClipKey = SkeletalPoseCache::hash(i->Timestamps.data(), uint32_t(i->Timestamps.size() * sizeof(float)), ClipKey);
+			ClipKey = SkeletalPoseCache::hash(i->Positions.data(), uint32_t(i->Positions.size() * sizeof(Vector3f)), ClipKey);
+			ClipKey = SkeletalPoseCache::hash(i->Rotations.data(), uint32_t(i->Rotations.size() * sizeof(Quaternionf)), ClipKey);
+			ClipKey = SkeletalPoseCache::hash(i->Scalings.data(), uint32_t(i->Scalings.size() * sizeof(Vector3f)), ClipKey);
+		}//for[keyframes]
+		m_ClipKeys.push_back(ClipKey);
+
+		// compressed animations keep only their compressed tracks
+		if (m_CompressionConfig.Enabled) {
+			m_CompressedTracks.push_back(std::vector<CompressedTrack>());
+			compressAnimation(pAnimation, &m_CompressedTracks.back());
+			m_SkeletalAnimations.push_back(pAnim);
+			m_SharedTimelines.push_back(false);
+			return;
+		}
+		m_CompressedTracks.push_back(std::vector<CompressedTrack>());
+
 		// keyframes and join names have to match
 		for (uint32_t i = 0; i < pAnimation->Keyframes.size(); ++i) {
 			int32_t JointID = jointIDFromName(pAnimation->Keyframes[i]->BoneName);
@@ -170,14 +216,27 @@ namespace CForge {
 			while (pKeyFrame->Scalings.size() < MaxTimestamps) pKeyFrame->Scalings.push_back(Scale);
 			while (pKeyFrame->Rotations.size() < MaxTimestamps) pKeyFrame->Rotations.push_back(Rot);
 		}
+
+		// do all joints share one timeline? Then the keyframe lookup has to be done only once per evaluation
+		const std::vector<float>* pTimeline = nullptr;
+		bool SharedTimeline = true;
+		for (auto i : pAnim->Keyframes) {
+			if (i->BoneName.empty() || i->Timestamps.empty()) continue;
+			if (nullptr == pTimeline) pTimeline = &i->Timestamps;
+			else if (i->Timestamps != (*pTimeline)) {
+				SharedTimeline = false;
+				break;
+			}
+		}//for[keyframes]
+		m_SharedTimelines.push_back(SharedTimeline);
 	
 	}//addAnimation
 
 	int32_t SkeletalAnimationController::jointIDFromName(std::string JointName) {
 		int32_t Rval = -1;
 
-		for (uint32_t i = 0; i < m_Joints.size(); ++i) {
-			if (m_Joints[i]->Name.compare(JointName) == 0) Rval = i;
+		for (uint32_t i = 0; i < m_JointNames.size(); ++i) {
+			if (m_JointNames[i].compare(JointName) == 0) Rval = i;
 		}
 
 		return Rval;
@@ -190,6 +249,14 @@ namespace CForge {
 		pRval->t = Offset;
 		pRval->Finished = false;
 		pRval->Duration = m_SkeletalAnimations[AnimationID]->Duration;
+		// unspecified tick rates default to 25 ticks per second (Assimp's convention)
+		pRval->TicksPerSecond = (m_SkeletalAnimations[AnimationID]->Speed > 0.0f) ? m_SkeletalAnimations[AnimationID]->Speed : 25.0f;
+		pRval->Cursors.assign(3 * m_JointNames.size(), 0);
+		pRval->LODTimeStep = 0.0f;
+		pRval->LODSkipLeafJoints = false;
+		pRval->LODKeysValid = false;
+		pRval->LODKey = 0;
+		pRval->LODKeyStep = 0.0f;
 		Animation* pTemp = pRval;
 		for (uint32_t i = 0; i < m_ActiveAnimations.size(); ++i) {
 			if (m_ActiveAnimations[i] == nullptr) {
@@ -225,68 +292,394 @@ namespace CForge {
 	}//destroyAnimation
 
 	void SkeletalAnimationController::applyAnimation(Animation* pAnim, bool UpdateUBO) {
+		evaluatePose(pAnim);
+		if (UpdateUBO) uploadPose();
+	}//applyAnimation
 
-		if (nullptr == pAnim) {
-			for (auto i : m_Joints) i->SkinningMatrix = Eigen::Matrix4f::Identity();
-		}
-		else {
-			T3DMesh<float>::SkeletalAnimation* pAnimData = m_SkeletalAnimations[pAnim->AnimationID];
+	void SkeletalAnimationController::evaluatePose(Animation* pAnim) {
 
-			if (pAnim->t > pAnimData->Duration) {
-				pAnim->t = pAnimData->Duration;
-				pAnim->Finished = true;
-			}
+		if (nullptr != pAnim && pAnim->t > m_SkeletalAnimations[pAnim->AnimationID]->Duration) {
+			pAnim->t = m_SkeletalAnimations[pAnim->AnimationID]->Duration;
+			pAnim->Finished = true;
+		}
 
-			// apply local transformations
-			for (uint32_t i = 0; i < pAnimData->Keyframes.size(); ++i) {
+		// same pose as last time? (e.g. further render passes of the same frame)
+		const int32_t AnimationID = (nullptr == pAnim) ? -1 : pAnim->AnimationID;
+		const float t = (nullptr == pAnim) ? 0.0f : pAnim->t;
+		const float LODTimeStep = (nullptr == pAnim) ? 0.0f : pAnim->LODTimeStep;
+		const bool LODSkipLeafJoints = (nullptr != pAnim) && pAnim->LODSkipLeafJoints;
+		const bool PoseCached = m_PoseValid && m_PoseAnimationID == AnimationID && m_PoseTime == t && m_PoseLODTimeStep == LODTimeStep && m_PoseLODSkipLeafJoints == LODSkipLeafJoints;
 
-				if (pAnimData->Keyframes[i]->BoneName.empty()) continue;
+		if (PoseCached) {
+			// nothing to evaluate
+		}
+		else if (nullptr == pAnim) {
+			for (auto& i : m_SkinningMatrices) i = Eigen::Matrix4f::Identity();
+		}
+		else if (LODTimeStep > 0.0f) {
+			computeLODPose(pAnim, t);
+		}
+		else {
+			computePose(pAnim, t);
+		}
 
-				if (pAnimData->Keyframes[i]->Timestamps.size() == 0) continue;
+		if (!PoseCached) {
+			m_PoseValid = true;
+			m_PoseAnimationID = AnimationID;
+			m_PoseTime = t;
+			m_PoseLODTimeStep = LODTimeStep;
+			m_PoseLODSkipLeafJoints = LODSkipLeafJoints;
+			m_UBODirty = true;
+			m_PoseVersion++;
+		}
+	}//evaluatePose
+
+	void SkeletalAnimationController::computePose(Animation* pAnim, float t) {
+		if (nullptr != m_pPoseCache) {
+			// shared pose of the quantized time, evaluated by whichever controller needs it first
+			const float Step = m_pPoseCache->timeStep();
+			const int64_t TimeIndex = int64_t(std::floor(t / Step + 0.5f));
+			const float QuantizedTime = std::min(float(TimeIndex) * Step, m_SkeletalAnimations[pAnim->AnimationID]->Duration);
+
+			if (!m_pPoseCache->retrieve(m_SkeletonKey, m_ClipKeys[pAnim->AnimationID], TimeIndex, &m_SkinningMatrices, &m_LocalPositions, &m_LocalRotations, &m_LocalScales)) {
+				sampleAnimation(pAnim, QuantizedTime);
+				transformSkeleton();
+				// poses with skipped leaf joints are not good enough for everyone
+				if (!pAnim->LODSkipLeafJoints) m_pPoseCache->store(m_SkeletonKey, m_ClipKeys[pAnim->AnimationID], TimeIndex, &m_SkinningMatrices, &m_LocalPositions, &m_LocalRotations, &m_LocalScales);
+			}
+		}
+		else {
+			sampleAnimation(pAnim, t);
+			transformSkeleton();
+		}
+	}//computePose
+
+	void SkeletalAnimationController::computeLODPose(Animation* pAnim, float t) {
+		const float Duration = m_SkeletalAnimations[pAnim->AnimationID]->Duration;
+		const float Step = pAnim->LODTimeStep * pAnim->TicksPerSecond;
+		const int64_t Key = int64_t(std::floor(t / Step));
+
+		// key poses belong to the animation, other animations of this controller do not invalidate them
+		const bool KeysMatch = pAnim->LODKeysValid && pAnim->LODKeyStep == Step && pAnim->LODNext.size() == m_SkinningMatrices.size();
+		if (!KeysMatch || Key != pAnim->LODKey) {
+			if (KeysMatch && Key == pAnim->LODKey + 1) {
+				// regular playback, the next key pose becomes the previous one
+				std::swap(pAnim->LODPrevious, pAnim->LODNext);
+			}
+			else {
+				computePose(pAnim, std::min(float(Key) * Step, Duration));
+				pAnim->LODPrevious = m_SkinningMatrices;
+			}
+			computePose(pAnim, std::min(float(Key + 1) * Step, Duration));
+			pAnim->LODNext = m_SkinningMatrices;
 
-				for (uint32_t k = 0; k < pAnimData->Keyframes[i]->Timestamps.size() - 1; ++k) {
-					float Time = pAnimData->Keyframes[i]->Timestamps[k];
-					float TimeP1 = pAnimData->Keyframes[i]->Timestamps[k + 1];
+			pAnim->LODKeysValid = true;
+			pAnim->LODKey = Key;
+			pAnim->LODKeyStep = Step;
+		}
 
-					if (Time <= pAnim->t && TimeP1 > pAnim->t) {
+		// interpolate the palette between the key poses
+		const float s = std::min(std::max((t - float(Key) * Step) / Step, 0.0f), 1.0f);
+		for (uint32_t i = 0; i < m_SkinningMatrices.size(); ++i) m_SkinningMatrices[i] = (1.0f - s) * pAnim->LODPrevious[i] + s * pAnim->LODNext[i];
+	}//computeLODPose
+
+	void SkeletalAnimationController::sampleAnimation(Animation* pAnim, float t) {
+		T3DMesh<float>::SkeletalAnimation* pAnimData = m_SkeletalAnimations[pAnim->AnimationID];
+		const bool SharedTimeline = m_SharedTimelines[pAnim->AnimationID];
+		const std::vector<CompressedTrack>* pTracks = &m_CompressedTracks[pAnim->AnimationID];
+		if (pAnim->Cursors.size() != 3 * m_JointNames.size()) pAnim->Cursors.assign(3 * m_JointNames.size(), 0);
+
+		uint32_t k = 0;
+		float s = 0.0f;
+		bool KeyFound = false;
+
+		// apply local transformations of compressed tracks
+		for (uint32_t i = 0; i < pTracks->size() && i < m_JointNames.size(); ++i) {
+			if (pAnim->LODSkipLeafJoints && m_JointChildren[i].empty()) continue;
+			const CompressedTrack* pTrack = &pTracks->at(i);
+			uint32_t* pCursors = &pAnim->Cursors[3 * i];
+
+			if (!pTrack->Positions.empty()) {
+				findKeyframe(&pTrack->PositionTimestamps, t, &pCursors[0], &k, &s);
+				const uint32_t k1 = (k + 1 < pTrack->Positions.size()) ? k + 1 : k;
+				m_LocalPositions[i] = (1.0f - s) * pTrack->Positions[k] + s * pTrack->Positions[k1];
+			}
+			if (!pTrack->Rotations.empty()) {
+				findKeyframe(&pTrack->RotationTimestamps, t, &pCursors[1], &k, &s);
+				const uint32_t k1 = (k + 1 < pTrack->Rotations.size()) ? k + 1 : k;
+				m_LocalRotations[i] = unpackQuaternion(pTrack->Rotations[k]).slerp(s, unpackQuaternion(pTrack->Rotations[k1]));
+			}
+			if (!pTrack->Scalings.empty()) {
+				findKeyframe(&pTrack->ScalingTimestamps, t, &pCursors[2], &k, &s);
+				const uint32_t k1 = (k + 1 < pTrack->Scalings.size()) ? k + 1 : k;
+				m_LocalScales[i] = (1.0f - s) * pTrack->Scalings[k] + s * pTrack->Scalings[k1];
+			}
+		}//for[compressed tracks]
+
+		// apply local transformations
+		for (uint32_t i = 0; i < pAnimData->Keyframes.size() && i < m_JointNames.size(); ++i) {
+			const T3DMesh<float>::BoneKeyframes* pKeys = pAnimData->Keyframes[i];
+
+			if (pKeys->BoneName.empty()) continue;
+			if (pKeys->Timestamps.size() == 0) continue;
+			if (pAnim->LODSkipLeafJoints && m_JointChildren[i].empty()) continue;
+
+			if (!SharedTimeline) findKeyframe(&pKeys->Timestamps, t, &pAnim->Cursors[3 * i], &k, &s);
+			else if (!KeyFound) findKeyframe(&pKeys->Timestamps, t, &pAnim->Cursors[0], &k, &s);
+			KeyFound = true;
+
+			const uint32_t k1 = (k + 1 < pKeys->Timestamps.size()) ? k + 1 : k;
+			m_LocalPositions[i] = (1.0f - s) * pKeys->Positions[k] + s * pKeys->Positions[k1];
+			m_LocalRotations[i] = pKeys->Rotations[k].slerp(s, pKeys->Rotations[k1]);
+			m_LocalScales[i] = (1.0f - s) * pKeys->Scalings[k] + s * pKeys->Scalings[k1];
+		}//for[keyframes]
+	}//sampleAnimation
+
+	void SkeletalAnimationController::uploadPose(void) {
+		if (!m_UBODirty) return;
+		m_UBO.skinningMatrices(m_SkinningMatrices.data(), uint32_t(m_SkinningMatrices.size()));
+		m_UBODirty = false;
+	}//uploadPose
+
+	void SkeletalAnimationController::findKeyframe(const std::vector<float>* pTimestamps, float t, uint32_t* pCursor, uint32_t* pKey, float* pS) {
+		const std::vector<float>& Timestamps = (*pTimestamps);
+		const uint32_t Count = uint32_t(Timestamps.size());
+
+		// clamp to start/end of the timeline
+		if (Count < 2 || t <= Timestamps[0]) {
+			(*pCursor) = 0;
+			(*pKey) = 0;
+			(*pS) = 0.0f;
+			return;
+		}
+		if (t >= Timestamps[Count - 1]) {
+			(*pCursor) = Count - 2;
+			(*pKey) = Count - 2;
+			(*pS) = 1.0f;
+			return;
+		}
 
-						float s = (pAnim->t - Time) / (TimeP1 - Time);
-						if (i < m_Joints.size()) {
-							m_Joints[i]->LocalPosition = (1.0f - s) * pAnimData->Keyframes[i]->Positions[k] + s * pAnimData->Keyframes[i]->Positions[k + 1];
-							m_Joints[i]->LocalRotation = pAnimData->Keyframes[i]->Rotations[k].slerp(s, pAnimData->Keyframes[i]->Rotations[k + 1]);
-							m_Joints[i]->LocalScale = (1.0f - s) * pAnimData->Keyframes[i]->Scalings[k] + s * pAnimData->Keyframes[i]->Scalings[k + 1];
-						}		
-						break;
-					}
-				}
+		// regular playback: same interval as last time or the next one
+		uint32_t k = (*pCursor);
+		if (k + 1 < Count && Timestamps[k] <= t && t < Timestamps[k + 1]) {
+			// cursor still valid
+		}
+		else if (k + 2 < Count && Timestamps[k + 1] <= t && t < Timestamps[k + 2]) {
+			k = k + 1;
+		}
+		else {
+			// seek, first timestamp greater than t
+			auto It = std::upper_bound(Timestamps.begin(), Timestamps.end(), t);
+			k = uint32_t(It - Timestamps.begin()) - 1;
+		}
 
-			}//for[keyframes]
+		(*pCursor) = k;
+		(*pKey) = k;
+		const float Delta = Timestamps[k + 1] - Timestamps[k];
+		(*pS) = (Delta > 0.0f) ? (t - Timestamps[k]) / Delta : 0.0f;
+	}//findKeyframe
+
+	void SkeletalAnimationController::compressionConfig(const CompressionConfig Config) {
+		m_CompressionConfig = Config;
+	}//compressionConfig
+
+	SkeletalAnimationController::CompressionConfig SkeletalAnimationController::compressionConfig(void)const {
+		return m_CompressionConfig;
+	}//compressionConfig
+
+	void SkeletalAnimationController::poseCache(SkeletalPoseCache* pCache) {
+		m_pPoseCache = pCache;
+		m_PoseValid = false;
+	}//poseCache
+
+	SkeletalPoseCache* SkeletalAnimationController::poseCache(void)const {
+		return m_pPoseCache;
+	}//poseCache
+
+	void SkeletalAnimationController::lod(Animation* pAnim, float TimeStep, bool SkipLeafJoints) {
+		if (nullptr == pAnim) throw NullpointerExcept("pAnim");
+		if (TimeStep < 0.0f) throw CForgeExcept("Negative time step specified!");
+		if (pAnim->LODTimeStep == TimeStep && pAnim->LODSkipLeafJoints == SkipLeafJoints) return;
+		pAnim->LODTimeStep = TimeStep;
+		pAnim->LODSkipLeafJoints = SkipLeafJoints;
+		m_PoseValid = false;
+	}//lod
+
+	void SkeletalAnimationController::compressAnimation(T3DMesh<float>::SkeletalAnimation* pAnimation, std::vector<CompressedTrack>* pTracks) {
+		pTracks->clear();
+		pTracks->resize(m_JointNames.size());
+
+		for (auto i : pAnimation->Keyframes) {
+			const int32_t JointID = jointIDFromName(i->BoneName);
+			if (JointID < 0 || i->Timestamps.empty()) continue;
+
+			// channels without own timestamps share the track's timestamps
+			CompressedTrack* pTrack = &pTracks->at(JointID);
+			std::vector<float> Timestamps;
+			std::vector<Eigen::Vector3f> Positions = i->Positions;
+			std::vector<Eigen::Quaternionf> Rotations = i->Rotations;
+			std::vector<Eigen::Vector3f> Scalings = i->Scalings;
+
+			Timestamps.assign(i->Timestamps.begin(), i->Timestamps.begin() + std::min(i->Timestamps.size(), Positions.size()));
+			Positions.resize(Timestamps.size());
+			reduceKeys(&Timestamps, &Positions, m_CompressionConfig.PositionTolerance, &pTrack->PositionTimestamps, &pTrack->Positions);
+
+			Timestamps.assign(i->Timestamps.begin(), i->Timestamps.begin() + std::min(i->Timestamps.size(), Rotations.size()));
+			Rotations.resize(Timestamps.size());
+			reduceKeys(&Timestamps, &Rotations, m_CompressionConfig.RotationTolerance, &pTrack->RotationTimestamps, &pTrack->Rotations);
+
+			Timestamps.assign(i->Timestamps.begin(), i->Timestamps.begin() + std::min(i->Timestamps.size(), Scalings.size()));
+			Scalings.resize(Timestamps.size());
+			reduceKeys(&Timestamps, &Scalings, m_CompressionConfig.ScalingTolerance, &pTrack->ScalingTimestamps, &pTrack->Scalings);
+		}//for[keyframes]
+	}//compressAnimation
+
+	void SkeletalAnimationController::reduceKeys(const std::vector<float>* pTimestamps, const std::vector<Eigen::Vector3f>* pValues, float Tolerance, std::vector<float>* pReducedTimestamps, std::vector<Eigen::Vector3f>* pReducedValues) {
+		const std::vector<float>& T = (*pTimestamps);
+		const std::vector<Vector3f>& V = (*pValues);
+		pReducedTimestamps->clear();
+		pReducedValues->clear();
+		if (V.empty()) return;
+
+		// constant track
+		bool Constant = true;
+		for (const auto& i : V) {
+			if ((i - V[0]).norm() > Tolerance) {
+				Constant = false;
+				break;
+			}
+		}
+		if (Constant) {
+			pReducedTimestamps->push_back(T[0]);
+			pReducedValues->push_back(V[0]);
+			return;
+		}
 
-			transformSkeleton(m_pRoot, Matrix4f::Identity());
+		// greedy: extend the segment starting at the last kept key as long as all skipped keys are reproduced by interpolation
+		uint32_t Anchor = 0;
+		pReducedTimestamps->push_back(T[0]);
+		pReducedValues->push_back(V[0]);
+		for (uint32_t End = 2; End < V.size(); ++End) {
+			bool Valid = true;
+			for (uint32_t k = Anchor + 1; k < End && Valid; ++k) {
+				const float s = (T[End] > T[Anchor]) ? (T[k] - T[Anchor]) / (T[End] - T[Anchor]) : 0.0f;
+				Valid = (((1.0f - s) * V[Anchor] + s * V[End]) - V[k]).norm() <= Tolerance;
+			}
+			if (!Valid) {
+				Anchor = End - 1;
+				pReducedTimestamps->push_back(T[Anchor]);
+				pReducedValues->push_back(V[Anchor]);
+			}
+		}//for[keys]
+		if (V.size() > 1) {
+			pReducedTimestamps->push_back(T.back());
+			pReducedValues->push_back(V.back());
+		}
+	}//reduceKeys
+
+	void SkeletalAnimationController::reduceKeys(const std::vector<float>* pTimestamps, const std::vector<Eigen::Quaternionf>* pValues, float Tolerance, std::vector<float>* pReducedTimestamps, std::vector<PackedQuaternion>* pReducedValues) {
+		const std::vector<float>& T = (*pTimestamps);
+		const std::vector<Quaternionf>& V = (*pValues);
+		pReducedTimestamps->clear();
+		pReducedValues->clear();
+		if (V.empty()) return;
+
+		// constant track
+		bool Constant = true;
+		for (const auto& i : V) {
+			if (i.angularDistance(V[0]) > Tolerance) {
+				Constant = false;
+				break;
+			}
+		}
+		if (Constant) {
+			pReducedTimestamps->push_back(T[0]);
+			pReducedValues->push_back(packQuaternion(V[0]));
+			return;
 		}
 
-		if (UpdateUBO) {
-			for (uint32_t i = 0; i < m_Joints.size(); ++i) m_UBO.skinningMatrix(i, m_Joints[i]->SkinningMatrix);
+		uint32_t Anchor = 0;
+		pReducedTimestamps->push_back(T[0]);
+		pReducedValues->push_back(packQuaternion(V[0]));
+		for (uint32_t End = 2; End < V.size(); ++End) {
+			bool Valid = true;
+			for (uint32_t k = Anchor + 1; k < End && Valid; ++k) {
+				const float s = (T[End] > T[Anchor]) ? (T[k] - T[Anchor]) / (T[End] - T[Anchor]) : 0.0f;
+				Valid = V[Anchor].slerp(s, V[End]).angularDistance(V[k]) <= Tolerance;
+			}
+			if (!Valid) {
+				Anchor = End - 1;
+				pReducedTimestamps->push_back(T[Anchor]);
+				pReducedValues->push_back(packQuaternion(V[Anchor]));
+			}
+		}//for[keys]
+		if (V.size() > 1) {
+			pReducedTimestamps->push_back(T.back());
+			pReducedValues->push_back(packQuaternion(V.back()));
 		}
-		
-	}//applyAnimation
+	}//reduceKeys
+
+	SkeletalAnimationController::PackedQuaternion SkeletalAnimationController::packQuaternion(Eigen::Quaternionf Q) {
+		// smallest three: drop the largest component, it can be reconstructed from the unit length
+		Q.normalize();
+		Vector4f C = Q.coeffs();
+		uint32_t Largest = 0;
+		for (uint32_t i = 1; i < 4; ++i) {
+			if (std::abs(C[i]) > std::abs(C[Largest])) Largest = i;
+		}
+		if (C[Largest] < 0.0f) C = -C; // q and -q are the same rotation
+
+		// remaining components are in [-1/sqrt(2), 1/sqrt(2)]
+		const float Range = 0.70710678f;
+		PackedQuaternion Rval;
+		uint32_t Index = 0;
+		for (uint32_t i = 0; i < 4; ++i) {
+			if (i == Largest) continue;
+			const float Normalized = std::min(std::max((C[i] / Range) * 0.5f + 0.5f, 0.0f), 1.0f);
+			Rval.Data[Index++] = uint16_t(std::round(Normalized * 32767.0f));
+		}
+		Rval.Data[0] |= uint16_t((Largest & 0x1) << 15);
+		Rval.Data[1] |= uint16_t((Largest & 0x2) << 14);
+		return Rval;
+	}//packQuaternion
+
+	Eigen::Quaternionf SkeletalAnimationController::unpackQuaternion(const PackedQuaternion Q) {
+		const float Range = 0.70710678f;
+		const uint32_t Largest = ((Q.Data[0] >> 15) & 0x1) | (((Q.Data[1] >> 15) & 0x1) << 1);
+
+		Vector4f C;
+		float SquaredSum = 0.0f;
+		uint32_t Index = 0;
+		for (uint32_t i = 0; i < 4; ++i) {
+			if (i == Largest) continue;
+			const float Normalized = float(Q.Data[Index++] & 0x7FFF) / 32767.0f;
+			C[i] = (Normalized * 2.0f - 1.0f) * Range;
+			SquaredSum += C[i] * C[i];
+		}
+		C[Largest] = std::sqrt(std::max(0.0f, 1.0f - SquaredSum));
+
+		Quaternionf Rval;
+		Rval.coeffs() = C;
+		return Rval;
+	}//unpackQuaternion
 
 	UBOBoneData* SkeletalAnimationController::ubo(void) {
 		return &m_UBO;
 	}//ubo
 
 
-	void SkeletalAnimationController::transformSkeleton(Joint* pJoint, Eigen::Matrix4f ParentTransform) {
-		if (nullptr == pJoint) throw NullpointerExcept("pJoint");
-		const Matrix4f R = CForgeMath::rotationMatrix(pJoint->LocalRotation);
-		const Matrix4f T = CForgeMath::translationMatrix(pJoint->LocalPosition);
-		const Matrix4f S = CForgeMath::scaleMatrix(pJoint->LocalScale);
-		const Matrix4f JointTransform = T * R * S;
+	void SkeletalAnimationController::transformSkeleton(void) {
+		// parents come before their children, so one pass over the evaluation order suffices
+		for (auto i : m_EvaluationOrder) {
+			// local transform T * R * S composed directly as affine 3x4 transformation
+			Affine3f JointTransform;
+			JointTransform.linear() = m_LocalRotations[i].toRotationMatrix() * m_LocalScales[i].asDiagonal();
+			JointTransform.translation() = m_LocalPositions[i];
 
-		Matrix4f LocalTransform =  ParentTransform * JointTransform;
-		pJoint->SkinningMatrix = LocalTransform * pJoint->OffsetMatrix;
-
-		for (auto i : pJoint->Children) transformSkeleton(i, LocalTransform);
+			const int32_t Parent = m_JointParents[i];
+			m_GlobalTransforms[i] = (Parent < 0) ? JointTransform : m_GlobalTransforms[Parent] * JointTransform;
+			m_SkinningMatrices[i] = (m_GlobalTransforms[i] * m_OffsetMatrices[i]).matrix();
+		}//for[joints]
 	}//transformSkeleton
 
 	T3DMesh<float>::SkeletalAnimation* SkeletalAnimationController::animation(uint32_t ID) {
@@ -294,6 +687,10 @@ namespace CForge {
 		return m_SkeletalAnimations[ID];
 	}//animation
 
+	uint32_t SkeletalAnimationController::jointCount(void)const {
+		return uint32_t(m_JointNames.size());
+	}//jointCount
+
 	uint32_t SkeletalAnimationController::animationCount(void)const {
 		return m_SkeletalAnimations.size();
 	}//animationCount
@@ -304,25 +701,31 @@ namespace CForge {
 
 	void SkeletalAnimationController::retrieveSkinningMatrices(std::vector<Eigen::Matrix4f>* pSkinningMats) {
 		if (nullptr == pSkinningMats) throw NullpointerExcept("pSkinningMats");
-		pSkinningMats->clear();
-		for (auto i : m_Joints) pSkinningMats->push_back(i->SkinningMatrix);
+		(*pSkinningMats) = m_SkinningMatrices;
 	}//retrieveSkinningMatrices
 
+	const Eigen::Matrix4f* SkeletalAnimationController::skinningMatrices(void)const {
+		return m_SkinningMatrices.data();
+	}//skinningMatrices
+
+	uint32_t SkeletalAnimationController::poseVersion(void)const {
+		return m_PoseVersion;
+	}//poseVersion
+
 	std::vector<SkeletalAnimationController::SkeletalJoint*> SkeletalAnimationController::retrieveSkeleton(void)const {
 		std::vector<SkeletalJoint*> Rval;
 
-		for (auto i : m_Joints) {
+		for (uint32_t i = 0; i < m_JointNames.size(); ++i) {
 			SkeletalJoint* pNewJoint = new SkeletalJoint();
-			pNewJoint->ID = i->ID;
-			pNewJoint->Name = i->Name;
-			pNewJoint->OffsetMatrix = i->OffsetMatrix;
-			pNewJoint->LocalPosition = i->LocalPosition;
-			pNewJoint->LocalRotation = i->LocalRotation;
-			pNewJoint->LocalScale = i->LocalScale;
-			pNewJoint->SkinningMatrix = i->SkinningMatrix;
-
-			pNewJoint->Parent = (i->pParent == nullptr) ? -1 : i->pParent->ID;
-			for (auto k : i->Children) pNewJoint->Children.push_back(k->ID);
+			pNewJoint->ID = i;
+			pNewJoint->Name = m_JointNames[i];
+			pNewJoint->OffsetMatrix = m_OffsetMatrices[i].matrix();
+			pNewJoint->LocalPosition = m_LocalPositions[i];
+			pNewJoint->LocalRotation = m_LocalRotations[i];
+			pNewJoint->LocalScale = m_LocalScales[i];
+			pNewJoint->SkinningMatrix = m_SkinningMatrices[i];
+			pNewJoint->Parent = m_JointParents[i];
+			pNewJoint->Children = m_JointChildren[i];
 			Rval.push_back(pNewJoint);
 		}
 		return Rval;
@@ -332,11 +735,12 @@ namespace CForge {
 		if (nullptr == pSkeleton) throw NullpointerExcept("pSkeleton");
 
 		for (auto i : (*pSkeleton)) {
-			i->OffsetMatrix = m_Joints[i->ID]->OffsetMatrix;
-			i->LocalPosition = m_Joints[i->ID]->LocalPosition;
-			i->LocalRotation = m_Joints[i->ID]->LocalRotation;
-			i->LocalScale = m_Joints[i->ID]->LocalScale;
-			i->SkinningMatrix = m_Joints[i->ID]->SkinningMatrix;
+			if (i->ID < 0 || i->ID >= int32_t(m_JointNames.size())) throw IndexOutOfBoundsExcept("Joint ID");
+			i->OffsetMatrix = m_OffsetMatrices[i->ID].matrix();
+			i->LocalPosition = m_LocalPositions[i->ID];
+			i->LocalRotation = m_LocalRotations[i->ID];
+			i->LocalScale = m_LocalScales[i->ID];
+			i->SkinningMatrix = m_SkinningMatrices[i->ID];
 		}
 	}//updateSkeleton
 
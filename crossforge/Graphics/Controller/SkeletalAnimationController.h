@@ -22,6 +22,7 @@
 #include "../UniformBufferObjects/UBOBoneData.h"
 #include "../Shader/ShaderCode.h"
 #include "../Shader/GLShader.h"
+#include "SkeletalPoseCache.h"
 
 namespace CForge {
 	class CFORGE_API SkeletalAnimationController: public CForgeObject {
@@ -31,8 +32,35 @@ namespace CForge {
 			float Speed;
 			float Duration;
 			float t; //current
-			float TicksPerSecond;
+			float TicksPerSecond; ///< Tick rate of the clip, t and Duration are in ticks
 			bool Finished;
+			std::vector<uint32_t> Cursors; ///< Playback cursors (last used keyframe), three per joint (position, rotation, scaling). Only the first entry is used if all joints share one timeline.
+
+			// level of detail, set with SkeletalAnimationController::lod
+			float LODTimeStep; ///< Seconds between two evaluated poses, 0 for full rate
+			bool LODSkipLeafJoints;
+			bool LODKeysValid;
+			int64_t LODKey; ///< Previous key pose is at LODKey * LODKeyStep ticks, next one a step later
+			float LODKeyStep;
+			std::vector<Eigen::Matrix4f> LODPrevious;
+			std::vector<Eigen::Matrix4f> LODNext;
+		};
+
+		/**
+		* \brief Keyframe compression applied to animations added afterwards. Keys that can be interpolated from their neighbours within the tolerance are removed, constant tracks are reduced to a single key and rotations are stored as quantized quaternions (smallest three, 48 bit). Every channel keeps its own timeline.
+		*/
+		struct CompressionConfig {
+			bool Enabled;
+			float PositionTolerance;	///< Maximum position error in model units
+			float RotationTolerance;	///< Maximum rotation error in radians
+			float ScalingTolerance;		///< Maximum scaling error
+
+			CompressionConfig(void) {
+				Enabled = false;
+				PositionTolerance = 0.0001f;
+				RotationTolerance = 0.0005f;
+				ScalingTolerance = 0.0001f;
+			}
 		};
 
 		struct SkeletalJoint: public CForgeObject {
@@ -64,48 +92,131 @@ namespace CForge {
 
 		void addAnimationData(T3DMesh<float>::SkeletalAnimation* pAnimation);
 
+		void compressionConfig(const CompressionConfig Config);
+		CompressionConfig compressionConfig(void)const;
+
+		/**
+		* \brief Sets a pose cache shared with other controllers (nullptr disables sharing). Animation time gets quantized to the cache's time step.
+		*/
+		void poseCache(SkeletalPoseCache* pCache);
+		SkeletalPoseCache* poseCache(void)const;
+
+		/**
+		* \brief Level of detail of an animation. With a time step greater than zero full poses are only evaluated at multiples of the time step and the skinning matrices in between are interpolated. Skipping leaf joints leaves their local transformation untouched during evaluation. The key poses are kept by the animation, so actors sharing the controller can use different levels.
+		* \param[in] pAnim Animation the level applies to.
+		* \param[in] TimeStep Seconds of animation time between two evaluated poses, converted to ticks with the clip's tick rate. 0 evaluates every call (full rate).
+		* \param[in] SkipLeafJoints Do not sample the keyframes of joints without children.
+		*/
+		void lod(Animation* pAnim, float TimeStep, bool SkipLeafJoints);
+
 		Animation* createAnimation(int32_t AnimationID, float Speed, float Offset);
 		void destroyAnimation(Animation* pAnim);
+
+		/**
+		* \brief Evaluates the pose of the animation (bind pose if pAnim is nullptr). The evaluated pose is cached by animation and time, so calling this several times per frame (once per render pass) evaluates the skeleton only once. The UBO is only uploaded if the pose changed since the last upload.
+		*/
 		void applyAnimation(Animation* pAnim, bool UpdateUBO = true);
 
+		/**
+		* \brief CPU part of applyAnimation. Does not touch OpenGL, so poses of different controllers can be evaluated concurrently on worker threads.
+		*/
+		void evaluatePose(Animation* pAnim);
+
+		/**
+		* \brief GL part of applyAnimation. Uploads the evaluated pose if it changed since the last upload. Has to be called from the thread owning the GL context.
+		*/
+		void uploadPose(void);
+
 		UBOBoneData* ubo(void);
 
 		T3DMesh<float>::SkeletalAnimation* animation(uint32_t ID);
 		uint32_t animationCount(void)const;
+		uint32_t jointCount(void)const;
 
 		GLShader* shadowPassShader(void);
 
 		UBOBoneData* boneUBO(void);
 		void retrieveSkinningMatrices(std::vector<Eigen::Matrix4f>* pSkinningMats);
+		const Eigen::Matrix4f* skinningMatrices(void)const; ///< Skinning matrices of the current pose, one per joint.
+		uint32_t poseVersion(void)const; ///< Changes every time a new pose gets evaluated.
 
 		std::vector<SkeletalJoint*> retrieveSkeleton(void)const;
 		void updateSkeletonValues(std::vector<SkeletalJoint*>* pSkeleton);
 
 	protected:
+		void transformSkeleton(void);
+		void sampleAnimation(Animation* pAnim, float t); ///< Interpolates the local transformations of all animated joints.
+		void computePose(Animation* pAnim, float t); ///< Samples and transforms the skeleton or gets the pose from the pose cache.
+		void computeLODPose(Animation* pAnim, float t);
+		int32_t jointIDFromName(std::string JointName);
 
-		struct Joint {
-			int32_t ID;
-			std::string Name;
-			Eigen::Matrix4f OffsetMatrix;
-			Eigen::Vector3f LocalPosition;
-			Eigen::Quaternionf LocalRotation;
-			Eigen::Vector3f LocalScale;
-			Eigen::Matrix4f SkinningMatrix;
-
-			Joint* pParent;
-			std::vector<Joint*> Children;
+		/**
+		* \brief Finds the keyframe interval containing t. Tries the cursor and its successor first and falls back to a binary search (seeking, looping). Times outside the timeline are clamped to the first/last keyframe.
+		* \param[in] Timestamps Sorted timestamps of the track.
+		* \param[in] t Time to look up.
+		* \param[in,out] pCursor Playback cursor. Gets updated to the found keyframe.
+		* \param[out] pKey First keyframe of the interval.
+		* \param[out] pS Interpolation parameter in [0,1] between pKey and pKey+1.
+		*/
+		static void findKeyframe(const std::vector<float>* pTimestamps, float t, uint32_t* pCursor, uint32_t* pKey, float* pS);
+
+		struct PackedQuaternion {
+			uint16_t Data[3]; ///< Three smallest components with 15 bits each, index of the dropped component in the high bits of Data[0] and Data[1]
 		};
 
-		void transformSkeleton(Joint* pJoint, Eigen::Matrix4f ParentTransform);
-		int32_t jointIDFromName(std::string JointName);
+		struct CompressedTrack {
+			std::vector<float> PositionTimestamps;
+			std::vector<Eigen::Vector3f> Positions;
+			std::vector<float> RotationTimestamps;
+			std::vector<PackedQuaternion> Rotations;
+			std::vector<float> ScalingTimestamps;
+			std::vector<Eigen::Vector3f> Scalings;
+		};
 
-		Joint* m_pRoot;
-		std::vector<Joint*> m_Joints;
+		static PackedQuaternion packQuaternion(Eigen::Quaternionf Q);
+		static Eigen::Quaternionf unpackQuaternion(const PackedQuaternion Q);
+		static void reduceKeys(const std::vector<float>* pTimestamps, const std::vector<Eigen::Vector3f>* pValues, float Tolerance, std::vector<float>* pReducedTimestamps, std::vector<Eigen::Vector3f>* pReducedValues);
+		static void reduceKeys(const std::vector<float>* pTimestamps, const std::vector<Eigen::Quaternionf>* pValues, float Tolerance, std::vector<float>* pReducedTimestamps, std::vector<PackedQuaternion>* pReducedValues);
+		void compressAnimation(T3DMesh<float>::SkeletalAnimation* pAnimation, std::vector<CompressedTrack>* pTracks);
+
+		// skeleton, indexed by joint ID
+		std::vector<std::string> m_JointNames;
+		std::vector<int32_t> m_JointParents; ///< Parent joint ID or -1 for roots
+		std::vector<std::vector<int32_t>> m_JointChildren;
+		std::vector<int32_t> m_EvaluationOrder; ///< Joint IDs in topological order (parents before children)
+		std::vector<Eigen::Affine3f> m_OffsetMatrices;
+
+		// local pose (structure of arrays)
+		std::vector<Eigen::Vector3f> m_LocalPositions;
+		std::vector<Eigen::Quaternionf> m_LocalRotations;
+		std::vector<Eigen::Vector3f> m_LocalScales;
+
+		// evaluated pose
+		std::vector<Eigen::Affine3f> m_GlobalTransforms;
+		std::vector<Eigen::Matrix4f> m_SkinningMatrices;
 			
 		std::vector<T3DMesh<float>::SkeletalAnimation*> m_SkeletalAnimations; // available animations for this skeleton
 		std::vector<Animation*> m_ActiveAnimations;
+		std::vector<bool> m_SharedTimelines; ///< Per animation: true if all joints use the same timestamps
+		std::vector<std::vector<CompressedTrack>> m_CompressedTracks; ///< Per animation: tracks indexed by joint ID, empty if the animation is not compressed
+		CompressionConfig m_CompressionConfig;
+
+		// pose sharing
+		SkeletalPoseCache* m_pPoseCache;
+		uint64_t m_SkeletonKey; ///< Hash of the skeleton's structure and bind pose
+		std::vector<uint64_t> m_ClipKeys; ///< Per animation: hash of the animation data
 
 		UBOBoneData m_UBO;
+
+		// cached pose
+		bool m_PoseValid;
+		int32_t m_PoseAnimationID; ///< -1 for bind pose
+		float m_PoseTime;
+		float m_PoseLODTimeStep;
+		bool m_PoseLODSkipLeafJoints;
+		bool m_UBODirty; ///< Pose changed since the last upload
+		uint32_t m_PoseVersion;
+
 		GLShader *m_pShadowPassShader;
 		ShaderCode* m_pShadowPassVSCode;
 		ShaderCode* m_pShadowPassFSCode;
@@ -0,0 +1,101 @@
+#include "../../Core/SThreadPool.h"
+#include "SkeletalAnimationSystem.h"
+
+namespace CForge {
+
+	SkeletalAnimationSystem::SkeletalAnimationSystem(void): CForgeObject("SkeletalAnimationSystem") {
+		m_pThreadPool = nullptr;
+	}//Constructor
+
+	SkeletalAnimationSystem::~SkeletalAnimationSystem(void) {
+		clear();
+	}//Destructor
+
+	void SkeletalAnimationSystem::init(void) {
+		clear();
+		m_pThreadPool = SThreadPool::instance();
+	}//initialize
+
+	void SkeletalAnimationSystem::clear(void) {
+		m_Actors.clear();
+		m_Jobs.clear();
+		if (nullptr != m_pThreadPool) m_pThreadPool->release();
+		m_pThreadPool = nullptr;
+	}//clear
+
+	void SkeletalAnimationSystem::addActor(SkeletalActor* pActor) {
+		if (nullptr == pActor) throw NullpointerExcept("pActor");
+		for (auto i : m_Actors) {
+			if (i == pActor) return;
+		}
+		m_Actors.push_back(pActor);
+	}//addActor
+
+	void SkeletalAnimationSystem::removeActor(SkeletalActor* pActor) {
+		for (auto i = m_Actors.begin(); i != m_Actors.end(); ++i) {
+			if ((*i) == pActor) {
+				m_Actors.erase(i);
+				break;
+			}
+		}
+	}//removeActor
+
+	uint32_t SkeletalAnimationSystem::actorCount(void)const {
+		return uint32_t(m_Actors.size());
+	}//actorCount
+
+	void SkeletalAnimationSystem::update(void) {
+		if (nullptr == m_pThreadPool) throw NotInitializedExcept("SkeletalAnimationSystem not initialized!");
+
+		// one job per controller, a controller can only hold one pose
+		m_Jobs.clear();
+		for (auto i : m_Actors) {
+			SkeletalAnimationController* pController = i->animationController();
+			SkeletalAnimationController::Animation* pAnim = i->activeAnimation();
+			if (nullptr == pController) continue;
+			// finished animations get replaced by the bind pose during rendering
+			if (nullptr != pAnim && pAnim->Finished) continue;
+
+			bool Found = false;
+			for (auto& k : m_Jobs) {
+				if (k.pController != pController) continue;
+				k.pAnimation = pAnim;
+				Found = true;
+				break;
+			}
+			if (!Found) {
+				PoseJob Job;
+				Job.pController = pController;
+				Job.pAnimation = pAnim;
+				m_Jobs.push_back(Job);
+			}
+		}//for[actors]
+
+		// shared pose caches start a new frame
+		for (uint32_t i = 0; i < m_Jobs.size(); ++i) {
+			SkeletalPoseCache* pCache = m_Jobs[i].pController->poseCache();
+			if (nullptr == pCache) continue;
+			bool Reset = false;
+			for (uint32_t k = 0; k < i && !Reset; ++k) Reset = (m_Jobs[k].pController->poseCache() == pCache);
+			if (!Reset) pCache->beginFrame();
+		}//for[jobs]
+
+		// evaluate on the worker threads
+		m_pThreadPool->parallelFor(uint32_t(m_Jobs.size()), [this](uint32_t Index) {
+			m_Jobs[Index].pController->evaluatePose(m_Jobs[Index].pAnimation);
+		});
+
+		// upload on the GL thread
+		for (auto& i : m_Jobs) i.pController->uploadPose();
+
+		// bounds of every actor showing an evaluated pose are ready for culling before the first render pass
+		for (auto i : m_Actors) {
+			for (const auto& k : m_Jobs) {
+				if (k.pController != i->animationController() || k.pAnimation != i->activeAnimation()) continue;
+				i->updateSkinnedBounds();
+				break;
+			}
+		}//for[actors]
+	}//update
+
+}//name space
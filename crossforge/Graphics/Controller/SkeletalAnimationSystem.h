@@ -0,0 +1,58 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): SkeletalAnimationSystem.h and SkeletalAnimationSystem.cpp        *
+*                                                                           *
+* Content: Evaluates the poses of skeletal actors in parallel before       *
+*          rendering.                                                       *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_SKELETALANIMATIONSYSTEM_H__
+#define __CFORGE_SKELETALANIMATIONSYSTEM_H__
+
+#include "../Actors/SkeletalActor.h"
+
+namespace CForge {
+	/**
+	* \brief Collects skeletal actors and evaluates the poses of their animation controllers on the worker threads of SThreadPool. The GL thread only uploads the results.
+	*
+	* Call update once per frame after the animations were progressed and before the first render pass. Actors then find their pose already evaluated and skip the evaluation. Every controller holds one pose, so if several registered actors share a controller with different animations, only the animation of the last registered one is evaluated in advance. Bounds get updated for all actors showing that animation, the others get evaluated during rendering as before.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API SkeletalAnimationSystem : public CForgeObject {
+	public:
+		SkeletalAnimationSystem(void);
+		~SkeletalAnimationSystem(void);
+
+		void init(void);
+		void clear(void);
+
+		void addActor(SkeletalActor* pActor);
+		void removeActor(SkeletalActor* pActor);
+		uint32_t actorCount(void)const;
+
+		void update(void);
+
+	protected:
+		struct PoseJob {
+			SkeletalAnimationController* pController;
+			SkeletalAnimationController::Animation* pAnimation;
+		};
+
+		std::vector<SkeletalActor*> m_Actors;
+		std::vector<PoseJob> m_Jobs; ///< One job per controller, rebuilt every update
+		class SThreadPool* m_pThreadPool;
+	};//SkeletalAnimationSystem
+
+}//name space
+
+#endif
@@ -0,0 +1,127 @@
+#include "../../Core/SFrameClock.h"
+#include "SkeletalPoseCache.h"
+
+namespace CForge {
+
+	uint64_t SkeletalPoseCache::hash(const void* pData, uint32_t Size, uint64_t Seed) {
+		const uint8_t* pBytes = (const uint8_t*)pData;
+		uint64_t Rval = Seed;
+		for (uint32_t i = 0; i < Size; ++i) {
+			Rval ^= pBytes[i];
+			Rval *= 1099511628211ULL;
+		}
+		return Rval;
+	}//hash
+
+	uint64_t SkeletalPoseCache::poseKey(uint64_t SkeletonKey, uint64_t ClipKey, int64_t TimeIndex) {
+		uint64_t Rval = hash(&SkeletonKey, sizeof(SkeletonKey));
+		Rval = hash(&ClipKey, sizeof(ClipKey), Rval);
+		Rval = hash(&TimeIndex, sizeof(TimeIndex), Rval);
+		return Rval;
+	}//poseKey
+
+	SkeletalPoseCache::SkeletalPoseCache(void): CForgeObject("SkeletalPoseCache") {
+		m_TimeStep = 1.0f;
+		m_PoseCount = 0;
+		m_MaxPoseCount = 0;
+		m_pClock = nullptr;
+		m_Frame = 0;
+	}//Constructor
+
+	SkeletalPoseCache::~SkeletalPoseCache(void) {
+		clear();
+	}//Destructor
+
+	void SkeletalPoseCache::init(float TimeStep, uint32_t MaxPoseCount) {
+		clear();
+		if (TimeStep <= 0.0f) throw CForgeExcept("Time step has to be greater than zero!");
+		if (0 == MaxPoseCount) throw CForgeExcept("Cache has to hold at least one pose!");
+		m_TimeStep = TimeStep;
+		m_MaxPoseCount = MaxPoseCount;
+		m_pClock = SFrameClock::instance();
+		m_Frame = m_pClock->frameCount();
+	}//initialize
+
+	void SkeletalPoseCache::clear(void) {
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_PoseIndices.clear();
+		m_Poses.clear();
+		m_PoseCount = 0;
+		m_MaxPoseCount = 0;
+		if (nullptr != m_pClock) m_pClock->release();
+		m_pClock = nullptr;
+		m_Frame = 0;
+	}//clear
+
+	void SkeletalPoseCache::beginFrame(void) {
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_PoseIndices.clear();
+		m_PoseCount = 0;
+		if (nullptr != m_pClock) m_Frame = m_pClock->frameCount();
+	}//beginFrame
+
+	void SkeletalPoseCache::dropOutdatedPoses(void) {
+		if (nullptr == m_pClock) throw NotInitializedExcept("Pose cache was not initialized!");
+		const uint64_t Frame = m_pClock->frameCount();
+		if (Frame == m_Frame) return;
+		m_PoseIndices.clear();
+		m_PoseCount = 0;
+		m_Frame = Frame;
+	}//dropOutdatedPoses
+
+	bool SkeletalPoseCache::retrieve(uint64_t SkeletonKey, uint64_t ClipKey, int64_t TimeIndex, std::vector<Eigen::Matrix4f>* pSkinningMatrices, std::vector<Eigen::Vector3f>* pLocalPositions, std::vector<Eigen::Quaternionf>* pLocalRotations, std::vector<Eigen::Vector3f>* pLocalScales) {
+		if (nullptr == pSkinningMatrices) throw NullpointerExcept("pSkinningMatrices");
+		if (nullptr == pLocalPositions) throw NullpointerExcept("pLocalPositions");
+		if (nullptr == pLocalRotations) throw NullpointerExcept("pLocalRotations");
+		if (nullptr == pLocalScales) throw NullpointerExcept("pLocalScales");
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		dropOutdatedPoses();
+		auto It = m_PoseIndices.find(poseKey(SkeletonKey, ClipKey, TimeIndex));
+		if (It == m_PoseIndices.end()) return false;
+
+		const Pose* pPose = &m_Poses[It->second];
+		(*pSkinningMatrices) = pPose->SkinningMatrices;
+		(*pLocalPositions) = pPose->LocalPositions;
+		(*pLocalRotations) = pPose->LocalRotations;
+		(*pLocalScales) = pPose->LocalScales;
+		return true;
+	}//retrieve
+
+	void SkeletalPoseCache::store(uint64_t SkeletonKey, uint64_t ClipKey, int64_t TimeIndex, const std::vector<Eigen::Matrix4f>* pSkinningMatrices, const std::vector<Eigen::Vector3f>* pLocalPositions, const std::vector<Eigen::Quaternionf>* pLocalRotations, const std::vector<Eigen::Vector3f>* pLocalScales) {
+		if (nullptr == pSkinningMatrices) throw NullpointerExcept("pSkinningMatrices");
+		if (nullptr == pLocalPositions) throw NullpointerExcept("pLocalPositions");
+		if (nullptr == pLocalRotations) throw NullpointerExcept("pLocalRotations");
+		if (nullptr == pLocalScales) throw NullpointerExcept("pLocalScales");
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		dropOutdatedPoses();
+		const uint64_t Key = poseKey(SkeletonKey, ClipKey, TimeIndex);
+		// another thread may have evaluated the same pose meanwhile
+		if (m_PoseIndices.find(Key) != m_PoseIndices.end()) return;
+		// full, start over
+		if (m_PoseCount == m_MaxPoseCount) {
+			m_PoseIndices.clear();
+			m_PoseCount = 0;
+		}
+
+		if (m_PoseCount == m_Poses.size()) m_Poses.push_back(Pose());
+		Pose* pPose = &m_Poses[m_PoseCount];
+		pPose->SkinningMatrices = (*pSkinningMatrices);
+		pPose->LocalPositions = (*pLocalPositions);
+		pPose->LocalRotations = (*pLocalRotations);
+		pPose->LocalScales = (*pLocalScales);
+		m_PoseIndices[Key] = m_PoseCount;
+		m_PoseCount++;
+	}//store
+
+	float SkeletalPoseCache::timeStep(void)const {
+		return m_TimeStep;
+	}//timeStep
+
+	uint32_t SkeletalPoseCache::poseCount(void)const {
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return m_PoseCount;
+	}//poseCount
+
+}//name space
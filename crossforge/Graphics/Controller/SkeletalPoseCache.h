@@ -0,0 +1,79 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): SkeletalPoseCache.h and SkeletalPoseCache.cpp                    *
+*                                                                           *
+* Content: Shares evaluated skeletal poses between animation controllers   *
+*          that play the same clip on the same skeleton.                   *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_SKELETALPOSECACHE_H__
+#define __CFORGE_SKELETALPOSECACHE_H__
+
+#include <mutex>
+#include <unordered_map>
+#include "../../Core/CForgeObject.h"
+
+namespace CForge {
+	/**
+	* \brief Cache of evaluated poses for crowds. Controllers using the cache quantize the animation time to the cache's time step and look up the pose by skeleton, clip, and quantized time before evaluating it. Controllers with identical skeletons and clips (e.g. all initialized from the same mesh) share their poses this way, so a crowd pays for a few unique poses only.
+	*
+	* Poses of previous frames are dropped automatically as soon as SFrameClock counts a new frame, so crowds evaluated during rendering need no further calls. Applications that do not tick the clock call beginFrame once per frame (SkeletalAnimationSystem does this for the caches of its controllers). The number of poses is limited in any case, a full cache starts over. Retrieving and storing poses is thread safe.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API SkeletalPoseCache : public CForgeObject {
+	public:
+		static uint64_t hash(const void* pData, uint32_t Size, uint64_t Seed = 14695981039346656037ULL); ///< FNV-1a hash, used to build skeleton and clip keys.
+
+		SkeletalPoseCache(void);
+		~SkeletalPoseCache(void);
+
+		/**
+		* \brief Initialization method.
+		* \param[in] TimeStep Animation time is quantized to multiples of this step. Larger steps mean more sharing but choppier playback.
+		* \param[in] MaxPoseCount Maximum number of poses held at once.
+		*/
+		void init(float TimeStep, uint32_t MaxPoseCount = 4096);
+		void clear(void);
+
+		void beginFrame(void);
+
+		bool retrieve(uint64_t SkeletonKey, uint64_t ClipKey, int64_t TimeIndex, std::vector<Eigen::Matrix4f>* pSkinningMatrices, std::vector<Eigen::Vector3f>* pLocalPositions, std::vector<Eigen::Quaternionf>* pLocalRotations, std::vector<Eigen::Vector3f>* pLocalScales);
+		void store(uint64_t SkeletonKey, uint64_t ClipKey, int64_t TimeIndex, const std::vector<Eigen::Matrix4f>* pSkinningMatrices, const std::vector<Eigen::Vector3f>* pLocalPositions, const std::vector<Eigen::Quaternionf>* pLocalRotations, const std::vector<Eigen::Vector3f>* pLocalScales);
+
+		float timeStep(void)const;
+		uint32_t poseCount(void)const; ///< Number of unique poses of the current frame.
+
+	protected:
+		struct Pose {
+			std::vector<Eigen::Matrix4f> SkinningMatrices;
+			std::vector<Eigen::Vector3f> LocalPositions;
+			std::vector<Eigen::Quaternionf> LocalRotations;
+			std::vector<Eigen::Vector3f> LocalScales;
+		};
+
+		static uint64_t poseKey(uint64_t SkeletonKey, uint64_t ClipKey, int64_t TimeIndex);
+		void dropOutdatedPoses(void); ///< Starts over if a new frame began, call with the mutex locked.
+
+		float m_TimeStep;
+		std::unordered_map<uint64_t, uint32_t> m_PoseIndices; ///< Pose key to index into m_Poses
+		std::vector<Pose> m_Poses; ///< Kept between frames to reuse the memory
+		uint32_t m_PoseCount; ///< Poses in use this frame
+		uint32_t m_MaxPoseCount;
+		class SFrameClock* m_pClock;
+		uint64_t m_Frame; ///< Frame count of the clock the poses belong to
+		mutable std::mutex m_Mutex;
+	};//SkeletalPoseCache
+
+}//name space
+
+#endif
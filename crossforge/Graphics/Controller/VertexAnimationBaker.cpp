@@ -0,0 +1,183 @@
+#include "../../AssetIO/File.h"
+#include "../Actors/VertexUtility.h"
+#include "VertexAnimationBaker.h"
+
+using namespace Eigen;
+
+namespace CForge {
+
+	// file header of stored baked animations
+	static const uint32_t BakedAnimationMagic = 0x41564643; // "CFVA"
+	static const uint32_t BakedAnimationVersion = 1;
+	static const uint32_t BakedAnimationMaxTextureSize = 16384; ///< Texture width and height limit for baking and loading
+
+	uint32_t VertexAnimationBaker::texelsPerElement(BakeMode Mode) {
+		uint32_t Rval = 0;
+		switch (Mode) {
+		case BAKE_VERTICES: Rval = 2; break;
+		case BAKE_SKINNINGMATRICES: Rval = 3; break;
+		default: throw CForgeExcept("Invalid bake mode specified!");
+		}
+		return Rval;
+	}//texelsPerElement
+
+	void VertexAnimationBaker::store(const std::string Filepath, const BakedAnimation* pAnim) {
+		if (nullptr == pAnim) throw NullpointerExcept("pAnim");
+		if (pAnim->Data.size() != size_t(pAnim->TextureWidth) * pAnim->TextureHeight * 4) throw CForgeExcept("Baked animation data is inconsistent!");
+
+		const uint32_t Header[7] = { BakedAnimationMagic, BakedAnimationVersion, uint32_t(pAnim->Mode), pAnim->FrameCount, pAnim->ElementCount, pAnim->TextureWidth, pAnim->TextureHeight };
+		const float Timing[2] = { pAnim->TimeStep, pAnim->Duration };
+		const float Bounds[6] = { pAnim->Bounds.min().x(), pAnim->Bounds.min().y(), pAnim->Bounds.min().z(), pAnim->Bounds.max().x(), pAnim->Bounds.max().y(), pAnim->Bounds.max().z() };
+
+		File F;
+		F.begin(Filepath, "wb");
+		F.write(Header, sizeof(Header));
+		F.write(Timing, sizeof(Timing));
+		F.write(Bounds, sizeof(Bounds));
+		F.write(pAnim->Data.data(), pAnim->Data.size() * sizeof(float));
+		F.end();
+	}//store
+
+	void VertexAnimationBaker::load(const std::string Filepath, BakedAnimation* pAnim) {
+		if (nullptr == pAnim) throw NullpointerExcept("pAnim");
+		if (!File::exists(Filepath)) throw CForgeExcept("File " + Filepath + " does not exist!");
+
+		uint32_t Header[7];
+		float Timing[2];
+		float Bounds[6];
+
+		File F;
+		F.begin(Filepath, "rb");
+		F.read(Header, sizeof(Header));
+		if (Header[0] != BakedAnimationMagic || Header[1] != BakedAnimationVersion) {
+			F.end();
+			throw CForgeExcept("File " + Filepath + " does not contain a baked animation!");
+		}
+		F.read(Timing, sizeof(Timing));
+		F.read(Bounds, sizeof(Bounds));
+
+		// reject corrupt headers before allocating anything
+		const bool ValidMode = (Header[2] == uint32_t(BAKE_VERTICES) || Header[2] == uint32_t(BAKE_SKINNINGMATRICES));
+		const bool ValidSize = Header[5] > 0 && Header[6] > 0 && Header[5] <= BakedAnimationMaxTextureSize && Header[6] <= BakedAnimationMaxTextureSize;
+		const bool ValidCount = ValidMode && Header[3] > 0 && Header[4] > 0 && uint64_t(Header[3]) * Header[4] * texelsPerElement(BakeMode(Header[2])) <= uint64_t(Header[5]) * Header[6];
+		if (!ValidMode || !ValidSize || !ValidCount) {
+			F.end();
+			throw CForgeExcept("File " + Filepath + " contains an invalid baked animation header!");
+		}
+
+		pAnim->Mode = BakeMode(Header[2]);
+		pAnim->FrameCount = Header[3];
+		pAnim->ElementCount = Header[4];
+		pAnim->TextureWidth = Header[5];
+		pAnim->TextureHeight = Header[6];
+		pAnim->TimeStep = Timing[0];
+		pAnim->Duration = Timing[1];
+		pAnim->Bounds = AlignedBox3f(Vector3f(Bounds[0], Bounds[1], Bounds[2]), Vector3f(Bounds[3], Bounds[4], Bounds[5]));
+		pAnim->Data.resize(size_t(pAnim->TextureWidth) * pAnim->TextureHeight * 4);
+		const uint64_t ByteCount = pAnim->Data.size() * sizeof(float);
+		const uint32_t Read = F.read(pAnim->Data.data(), ByteCount);
+		F.end();
+
+		if (Read != ByteCount) throw CForgeExcept("File " + Filepath + " is truncated!");
+	}//load
+
+	VertexAnimationBaker::VertexAnimationBaker(void): CForgeObject("VertexAnimationBaker") {
+		m_pMesh = nullptr;
+		m_pController = nullptr;
+	}//Constructor
+
+	VertexAnimationBaker::~VertexAnimationBaker(void) {
+		clear();
+	}//Destructor
+
+	void VertexAnimationBaker::init(const T3DMesh<float>* pMesh, SkeletalAnimationController* pController) {
+		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
+		if (nullptr == pController) throw NullpointerExcept("pController");
+		clear();
+
+		m_Skinning.init(pMesh);
+		VertexUtility::buildBoneInfluenceSpheres(pMesh, &m_BoneInfluences);
+		m_pMesh = pMesh;
+		m_pController = pController;
+	}//initialize
+
+	void VertexAnimationBaker::clear(void) {
+		m_Skinning.clear();
+		m_BoneInfluences.clear();
+		m_pMesh = nullptr;
+		m_pController = nullptr;
+	}//clear
+
+	void VertexAnimationBaker::bake(BakedAnimation* pRval, int32_t AnimationID, float TimeStep, BakeMode Mode, uint32_t MaxTextureWidth) {
+		if (nullptr == pRval) throw NullpointerExcept("pRval");
+		if (nullptr == m_pController) throw NotInitializedExcept("Vertex animation baker was not initialized!");
+		if (AnimationID < 0 || uint32_t(AnimationID) >= m_pController->animationCount()) throw IndexOutOfBoundsExcept("AnimationID");
+		if (TimeStep <= 0.0f) throw CForgeExcept("Time step has to be greater than zero!");
+		if (MaxTextureWidth == 0 || MaxTextureWidth > BakedAnimationMaxTextureSize) throw CForgeExcept("Maximum texture width has to be in [1, " + std::to_string(BakedAnimationMaxTextureSize) + "]!");
+
+		const float Duration = m_pController->animation(AnimationID)->Duration;
+		const uint32_t FrameCount = (Duration > 0.0f) ? uint32_t(std::ceil(Duration / TimeStep)) + 1 : 1;
+		const uint32_t JointCount = m_pController->jointCount();
+		if (m_BoneInfluences.size() > JointCount) throw CForgeExcept("Mesh has more bones than the controller's skeleton has joints!");
+
+		pRval->Mode = Mode;
+		pRval->FrameCount = FrameCount;
+		pRval->ElementCount = (Mode == BAKE_VERTICES) ? m_Skinning.vertexCount() : JointCount;
+		pRval->TimeStep = (FrameCount > 1) ? Duration / float(FrameCount - 1) : TimeStep;
+		pRval->Duration = Duration;
+		pRval->Bounds.setEmpty();
+
+		const uint32_t TexelsPerElement = texelsPerElement(Mode);
+		const uint64_t TexelCount = uint64_t(FrameCount) * pRval->ElementCount * TexelsPerElement;
+		pRval->TextureWidth = uint32_t(std::min(uint64_t(MaxTextureWidth), TexelCount));
+		pRval->TextureHeight = uint32_t((TexelCount + pRval->TextureWidth - 1) / pRval->TextureWidth);
+		if (pRval->TextureHeight > MaxTextureWidth) throw CForgeExcept("Baked animation exceeds the maximum texture size. Increase the time step or bake skinning matrices.");
+		pRval->Data.assign(size_t(pRval->TextureWidth) * pRval->TextureHeight * 4, 0.0f);
+
+		// sample the clip without a shared cache, restore it afterwards (new animations run at full rate)
+		SkeletalPoseCache* pPoseCache = m_pController->poseCache();
+		m_pController->poseCache(nullptr);
+		SkeletalAnimationController::Animation* pAnim = m_pController->createAnimation(AnimationID, 1.0f, 0.0f);
+
+		try {
+			for (uint32_t Frame = 0; Frame < FrameCount; ++Frame) {
+				pAnim->t = std::min(Frame * pRval->TimeStep, Duration);
+				pAnim->Finished = false;
+				m_pController->evaluatePose(pAnim);
+
+				const Matrix4f* pSkinningMats = m_pController->skinningMatrices();
+				float* pData = &pRval->Data[size_t(Frame) * pRval->ElementCount * TexelsPerElement * 4];
+				if (Mode == BAKE_VERTICES) {
+					m_Skinning.skin(pSkinningMats, JointCount);
+					pRval->Bounds.extend(m_Skinning.bounds());
+					for (uint32_t i = 0; i < pRval->ElementCount; ++i) {
+						const Vector3f P = m_Skinning.position(i);
+						const Vector3f N = m_Skinning.normal(i);
+						pData[0] = P.x(); pData[1] = P.y(); pData[2] = P.z(); pData[3] = 1.0f;
+						pData[4] = N.x(); pData[5] = N.y(); pData[6] = N.z(); pData[7] = 0.0f;
+						pData += 8;
+					}//for[vertices]
+				}
+				else {
+					// no vertex has to be skinned for the bounds
+					pRval->Bounds.extend(VertexUtility::skinnedBounds(&m_BoneInfluences, pSkinningMats));
+					for (uint32_t i = 0; i < pRval->ElementCount; ++i) {
+						for (uint32_t Row = 0; Row < 3; ++Row) {
+							for (uint32_t Col = 0; Col < 4; ++Col) pData[Col] = pSkinningMats[i](Row, Col);
+							pData += 4;
+						}//for[rows]
+					}//for[joints]
+				}
+			}//for[frames]
+		}
+		catch (...) {
+			m_pController->destroyAnimation(pAnim);
+			m_pController->poseCache(pPoseCache);
+			throw;
+		}
+
+		m_pController->destroyAnimation(pAnim);
+		m_pController->poseCache(pPoseCache);
+	}//bake
+
+}//name space
@@ -0,0 +1,99 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): VertexAnimationBaker.h and VertexAnimationBaker.cpp              *
+*                                                                           *
+* Content: Samples skeletal animation clips at a fixed rate and bakes them  *
+*          into float texture data for playback in the vertex shader.      *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_VERTEXANIMATIONBAKER_H__
+#define __CFORGE_VERTEXANIMATIONBAKER_H__
+
+#include "../../AssetIO/T3DMesh.hpp"
+#include "../../MeshProcessing/CPUSkinning.h"
+#include "SkeletalAnimationController.h"
+
+namespace CForge {
+	/**
+	* \brief Bakes a clip of a SkeletalAnimationController into texture data, so crowds can be animated entirely on the GPU (see VertexAnimationActor).
+	*
+	* Baked vertices store the skinned position and normal of every vertex per frame (two RGBA texels per vertex). Baked skinning matrices store the upper three rows of every joint's skinning matrix per frame (three RGBA texels per joint), which is far smaller for dense meshes but still requires skinning in the shader. Texels are laid out frame after frame and wrapped into rows of at most MaxTextureWidth texels.
+	*
+	* Baked animations can be stored and loaded, so baking can happen offline.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API VertexAnimationBaker : public CForgeObject {
+	public:
+		enum BakeMode : int32_t {
+			BAKE_VERTICES = 0,			///< Skinned position and normal per vertex
+			BAKE_SKINNINGMATRICES = 1,	///< Skinning matrix per joint
+		};
+
+		struct BakedAnimation {
+			BakeMode Mode;
+			uint32_t FrameCount;
+			uint32_t ElementCount;		///< Vertices or joints per frame
+			float TimeStep;				///< Animation time between two frames
+			float Duration;				///< Animation time of the whole clip ((FrameCount - 1) * TimeStep)
+			uint32_t TextureWidth;
+			uint32_t TextureHeight;
+			std::vector<float> Data;	///< RGBA texels, row after row
+			Eigen::AlignedBox3f Bounds;	///< Bounds of the skinned mesh over all frames (conservative from bone influence spheres for baked skinning matrices)
+
+			BakedAnimation(void) {
+				Mode = BAKE_VERTICES;
+				FrameCount = 0;
+				ElementCount = 0;
+				TimeStep = 0.0f;
+				Duration = 0.0f;
+				TextureWidth = 0;
+				TextureHeight = 0;
+			}
+		};
+
+		static uint32_t texelsPerElement(BakeMode Mode);
+
+		static void store(const std::string Filepath, const BakedAnimation* pAnim);
+		static void load(const std::string Filepath, BakedAnimation* pAnim);
+
+		VertexAnimationBaker(void);
+		~VertexAnimationBaker(void);
+
+		/**
+		* \brief Initialization.
+		* \param[in] pMesh Skinned mesh the controller was initialized with. Required to compute bounds and baked vertices.
+		* \param[in] pController Controller providing skeleton and clips.
+		*/
+		void init(const T3DMesh<float>* pMesh, SkeletalAnimationController* pController);
+		void clear(void);
+
+		/**
+		* \brief Samples a clip and bakes it.
+		* \param[out] pRval Baked animation.
+		* \param[in] AnimationID Clip of the controller.
+		* \param[in] TimeStep Desired animation time between two frames. Gets adjusted slightly, so the last frame hits the end of the clip.
+		* \param[in] Mode What to bake.
+		* \param[in] MaxTextureWidth Maximum number of texels per texture row.
+		*/
+		void bake(BakedAnimation* pRval, int32_t AnimationID, float TimeStep, BakeMode Mode, uint32_t MaxTextureWidth = 4096);
+
+	protected:
+		const T3DMesh<float>* m_pMesh;
+		SkeletalAnimationController* m_pController;
+		CPUSkinning m_Skinning;
+		std::vector<Eigen::Vector4f> m_BoneInfluences; ///< Per bone influence spheres, see VertexUtility::buildBoneInfluenceSpheres
+	};//VertexAnimationBaker
+
+}//name space
+
+#endif
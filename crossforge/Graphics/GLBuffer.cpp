@@ -102,6 +102,10 @@ namespace CForge {
 		glBindBufferRange(m_GLTarget, BindingPoint, m_GLID, 0, m_BufferSize);
 	}//bindBufferBase
 
+	void GLBuffer::bindBufferRange(uint32_t BindingPoint, uint32_t Offset, uint32_t Size) {
+		glBindBufferRange(m_GLTarget, BindingPoint, m_GLID, Offset, Size);
+	}//bindBufferRange
+
 	void GLBuffer::bindTextureBuffer(uint32_t ActiveTexture, uint32_t Format) {
 		glActiveTexture(GL_TEXTURE0 + ActiveTexture);
 		glBindTexture(GL_TEXTURE_BUFFER, m_TextureHandle);
@@ -51,6 +51,7 @@ namespace CForge {
 
 		void bind(void);
 		void bindBufferBase(uint32_t BindingPoint);
+		void bindBufferRange(uint32_t BindingPoint, uint32_t Offset, uint32_t Size);
 		void bindTextureBuffer(uint32_t ActiveTexture, uint32_t Format);
 		void unbind(void);
 
@@ -36,6 +36,8 @@ namespace CForge {
 
 		ForwardBufferWidth = 0;
 		ForwardBufferHeight = 0;
+
+		UseRenderQueue = false;
 	}
 
 	RenderDevice::RenderDevice(void) : CForgeObject("RenderDevice") {
@@ -43,6 +45,12 @@ namespace CForge {
 		m_pActiveMaterial = nullptr;
 		m_pActiveShader = nullptr;
 		m_pShadowPassShader = nullptr;
+		m_pActiveShadowLight = nullptr;
+		m_ActiveRenderPass = RENDERPASS_UNKNOWN;
+		m_RenderQueueEnabled = false;
+		m_FlushingRenderQueue = false;
+		m_QueueModelSlot = 0;
+		m_QueueWrapCount = 0;
 	}//Constructor
 
 	RenderDevice::~RenderDevice(void) {
@@ -65,6 +73,10 @@ namespace CForge {
 		m_MaterialUBO.init();
 		m_LightsUBO.init(m_Config.DirectionalLightsCount, m_Config.PointLightsCount, m_Config.SpotLightsCount);
 
+		m_RenderQueue.init();
+		m_RenderQueueEnabled = m_Config.UseRenderQueue;
+		m_FlushingRenderQueue = false;
+
 		if (GL_NO_ERROR != CForgeUtility::checkGLError(&ErrorMsg)) {
 			SLogger::log("Not handled OpenGL error occurred during initialization of UBOs: " + ErrorMsg, "RenderDevice", SLogger::LOGTYPE_ERROR);
 		}
@@ -162,22 +174,169 @@ namespace CForge {
 	void RenderDevice::requestRendering(IRenderableActor* pActor, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale) {
 		if (nullptr == pActor) throw NullpointerExcept("pActor");
 
-		////// create model matrix and update buffer
-		const Matrix4f R = CForgeMath::rotationMatrix(Rotation);
-		const Matrix4f T = CForgeMath::translationMatrix(Translation);
-		const Matrix4f S = CForgeMath::scaleMatrix(Scale);
-		const Matrix4f ModelMat = T * R * S;
-
-		Matrix4f NormalMat = ModelMat.inverse().transpose();
+		// record for sorted submission? Requests issued while flushing (nested scene graphs) are rendered right away
+		if (m_RenderQueueEnabled && !m_FlushingRenderQueue) {
+			if (m_ActiveRenderPass == RENDERPASS_SHADOW || m_ActiveRenderPass == RENDERPASS_GEOMETRY || m_ActiveRenderPass == RENDERPASS_FORWARD) {
+				enqueueRendering(pActor, Rotation, Translation, Scale);
+				return;
+			}
+		}
 
-		m_ModelUBO.modelMatrix(ModelMat);
-		m_ModelUBO.normalMatrix(NormalMat);
+		updateModelData(Rotation, Translation, Scale);
 
 		// render the object with current settings
 		pActor->render(this, Rotation, Translation, Scale);
 
 	}//requestRendering
 
+	void RenderDevice::updateModelData(const Eigen::Quaternionf Rotation, const Eigen::Vector3f Translation, const Eigen::Vector3f Scale) {
+		// writes a fresh ring buffer slot, normal matrix comes straight from rotation and scale
+		m_ModelUBO.update(CForgeMath::modelMatrix(Rotation, Translation, Scale), CForgeMath::normalMatrix(Rotation, Scale));
+		bindModelData();
+	}//updateModelData
+
+	void RenderDevice::queuedModelData(uint32_t TransformIndex) {
+		if (m_ModelUBO.wrapCount() != m_QueueWrapCount) {
+			// nested requests wrapped the ring buffer, slots of the queue may have been overwritten
+			const RenderQueue::Transform* pTransform = m_RenderQueue.transform(TransformIndex);
+			updateModelData(pTransform->Rotation, pTransform->Translation, pTransform->Scale);
+		}
+		else {
+			m_ModelUBO.activeSlot(m_QueueModelSlot + TransformIndex);
+			bindModelData();
+		}
+	}//queuedModelData
+
+	void RenderDevice::bindModelData(void) {
+		// the active shader does not get rebound, so point its binding to the new slot
+		if (nullptr == m_pActiveShader) return;
+		const uint32_t BindingPoint = m_pActiveShader->uboBindingPoint(GLShader::DEFAULTUBO_MODELDATA);
+		if (GL_INVALID_INDEX != BindingPoint) m_ModelUBO.bind(BindingPoint);
+	}//bindModelData
+
+	void RenderDevice::enqueueRendering(IRenderableActor* pActor, const Eigen::Quaternionf Rotation, const Eigen::Vector3f Translation, const Eigen::Vector3f Scale) {
+		const uint32_t TransformIndex = m_RenderQueue.addTransform(Rotation, Translation, Scale);
+
+		if (pActor->renderGroupsQueueable()) {
+			for (uint32_t i = 0; i < pActor->materialCount(); ++i) {
+				GLShader* pShader = pActor->renderGroupShader(this, i, false);
+				if (nullptr == pShader) continue;
+				const uint64_t Key = RenderQueue::sortKey(m_ActiveRenderPass, pShader->objectID(), pActor->material(i)->objectID(), pActor->vertexArrayID(), i);
+				m_RenderQueue.addItem(pActor, i, TransformIndex, Key);
+			}//for[render groups]
+		}
+		else {
+			// actor renders as a whole, sort by the state of its first render group
+			uint32_t ShaderID = 0;
+			uint32_t MaterialID = 0;
+			if (pActor->materialCount() > 0) {
+				GLShader* pShader = pActor->renderGroupShader(this, 0, false);
+				if (nullptr != pShader) ShaderID = pShader->objectID();
+				MaterialID = pActor->material(0)->objectID();
+			}
+			const uint64_t Key = RenderQueue::sortKey(m_ActiveRenderPass, ShaderID, MaterialID, pActor->vertexArrayID(), 0);
+			m_RenderQueue.addItem(pActor, -1, TransformIndex, Key);
+		}
+	}//enqueueRendering
+
+	void RenderDevice::enableRenderQueue(bool Enable) {
+		m_RenderQueueEnabled = Enable;
+	}//enableRenderQueue
+
+	bool RenderDevice::renderQueueEnabled(void)const {
+		return m_RenderQueueEnabled;
+	}//renderQueueEnabled
+
+	void RenderDevice::flushRenderQueue(void) {
+		// nested flushes (actors rendering own scene graphs) have nothing to submit
+		if (m_FlushingRenderQueue || m_RenderQueue.size() == 0) return;
+
+		m_FlushingRenderQueue = true;
+		m_RenderQueue.sort();
+
+		IRenderableActor* pBoundActor = nullptr;
+		uint32_t ActiveTransform = CForgeObject::INVALID_ID;
+
+		// coalesced instanced draws carry world transformations per instance and use identity model data
+		const uint32_t IdentityTransform = m_RenderQueue.addTransform(Quaternionf::Identity(), Vector3f::Zero(), Vector3f::Ones());
+		IRenderableActor* pInstancedActor = nullptr; // actor whose instance buffer holds m_QueuedInstances
+		m_QueuedInstances.clear();
+
+		// model data of all queued requests is uploaded at once, draws only select their slot
+		m_QueueModelSlot = m_ModelUBO.reserve(m_RenderQueue.transformCount());
+		for (uint32_t k = 0; k < m_RenderQueue.transformCount(); ++k) {
+			const RenderQueue::Transform* pTransform = m_RenderQueue.transform(k);
+			m_ModelUBO.slotData(m_QueueModelSlot + k, CForgeMath::modelMatrix(pTransform->Rotation, pTransform->Translation, pTransform->Scale), CForgeMath::normalMatrix(pTransform->Rotation, pTransform->Scale));
+		}//for[transformations]
+		m_ModelUBO.upload(m_QueueModelSlot, m_RenderQueue.transformCount());
+		m_QueueWrapCount = m_ModelUBO.wrapCount();
+
+		uint32_t i = 0;
+		while (i < m_RenderQueue.size()) {
+			const RenderQueue::Item* pItem = m_RenderQueue.item(i);
+
+			// find consecutive requests of the same actor and render group
+			uint32_t RunEnd = i + 1;
+			if (pItem->RenderGroup >= 0 && pItem->pActor->isInstanced() && !pItem->pActor->isManualInstanced()) {
+				while (RunEnd < m_RenderQueue.size() && m_RenderQueue.item(RunEnd)->pActor == pItem->pActor && m_RenderQueue.item(RunEnd)->RenderGroup == pItem->RenderGroup) RunEnd++;
+			}
+
+			if (RunEnd - i > 1) {
+				// other render groups of the actor usually share the instances, upload only on change
+				bool Changed = (pInstancedActor != pItem->pActor || m_QueuedInstances.size() != (RunEnd - i));
+				for (uint32_t k = i; k < RunEnd && !Changed; ++k) Changed = (m_QueuedInstances[k - i] != m_RenderQueue.item(k)->TransformIndex);
+
+				if (Changed) {
+					m_QueuedInstances.clear();
+					m_InstanceMatrices.clear();
+					for (uint32_t k = i; k < RunEnd; ++k) {
+						const uint32_t TransformIndex = m_RenderQueue.item(k)->TransformIndex;
+						const RenderQueue::Transform* pTransform = m_RenderQueue.transform(TransformIndex);
+						m_QueuedInstances.push_back(TransformIndex);
+						m_InstanceMatrices.push_back(CForgeMath::modelMatrix(pTransform->Rotation, pTransform->Translation, pTransform->Scale));
+					}//for[instances]
+					pItem->pActor->instanceData(m_InstanceMatrices.data(), m_InstanceMatrices.size());
+					pInstancedActor = pItem->pActor;
+				}
+
+				if (ActiveTransform != IdentityTransform) {
+					queuedModelData(IdentityTransform);
+					ActiveTransform = IdentityTransform;
+				}
+				pItem->pActor->renderGroupInstanced(this, pItem->RenderGroup, RunEnd - i, pItem->pActor != pBoundActor);
+				pBoundActor = pItem->pActor;
+				i = RunEnd;
+				continue;
+			}
+
+			const RenderQueue::Transform* pTransform = m_RenderQueue.transform(pItem->TransformIndex);
+
+			// render groups of the same request share their model data
+			if (pItem->TransformIndex != ActiveTransform) {
+				queuedModelData(pItem->TransformIndex);
+				ActiveTransform = pItem->TransformIndex;
+			}
+
+			if (pItem->RenderGroup < 0) {
+				pItem->pActor->render(this, pTransform->Rotation, pTransform->Translation, pTransform->Scale);
+				// actor may have issued own requests (nested scene graphs)
+				pBoundActor = nullptr;
+				ActiveTransform = CForgeObject::INVALID_ID;
+			}
+			else {
+				// vertex array stays bound while consecutive items belong to the same actor
+				pItem->pActor->renderGroup(this, pItem->RenderGroup, pItem->pActor != pBoundActor);
+				pBoundActor = pItem->pActor;
+			}
+			i++;
+		}//while[queued items]
+
+		if (nullptr != pBoundActor) glBindVertexArray(0);
+
+		m_RenderQueue.clear();
+		m_FlushingRenderQueue = false;
+	}//flushRenderQueue
+
 	void RenderDevice::activeShader(GLShader* pShader) {
 		if (pShader == nullptr) {
 			m_pActiveShader = nullptr;
@@ -274,6 +433,11 @@ namespace CForge {
 		return m_pActiveCamera;
 	}//activeCamera
 
+	const ViewFrustum* RenderDevice::cullingFrustum(void)const {
+		if (m_ActiveRenderPass == RENDERPASS_SHADOW && nullptr != m_pActiveShadowLight) return &m_ShadowFrustum;
+		return (nullptr != m_pActiveCamera) ? m_pActiveCamera->viewFrustum() : nullptr;
+	}//cullingFrustum
+
 	UBOCameraData* RenderDevice::cameraUBO(void) {
 		return &m_CameraUBO;
 	}//cameraUBO
@@ -395,6 +559,9 @@ namespace CForge {
 	}//updateMaterial
 
 	void RenderDevice::activePass(RenderPass Pass, ILight* pActiveLight, bool ClearBuffer) {
+		// queued requests belong to the previous pass
+		flushRenderQueue();
+
 		m_ActiveRenderPass = Pass;
 
 		m_pActiveShadowLight = nullptr;
@@ -426,6 +593,7 @@ namespace CForge {
 				
 				glCullFace(GL_FRONT); // cull front face to solve peter-panning shadow artifact
 				m_pActiveShadowLight = pAL;
+				m_ShadowFrustum.init(Eigen::Matrix4f(pAL->pLight->projectionMatrix() * pAL->pLight->viewMatrix()));
 			}
 		}break;
 		case RENDERPASS_GEOMETRY: {
@@ -34,6 +34,7 @@
 #include "UniformBufferObjects/UBOMaterialData.h"
 #include "UniformBufferObjects/UBOModelData.h"
 #include "Shader/GLShader.h"
+#include "RenderQueue.h"
 
 
 namespace CForge {
@@ -73,6 +74,8 @@ namespace CForge {
 			int32_t ForwardBufferWidth;
 			int32_t ForwardBufferHeight;
 
+			bool UseRenderQueue; ///< Record draw requests and submit them sorted by render state.
+
 			RenderDeviceConfig(void);
 			~RenderDeviceConfig(void);
 			void init(void);
@@ -91,6 +94,13 @@ namespace CForge {
 
 		void requestRendering(IRenderableActor* pActor, Eigen::Quaternionf Rotation, Eigen::Vector3f Translation, Eigen::Vector3f Scale);
 
+		/**
+		* \brief Enables or disables the deferred render queue. While enabled, render requests of the shadow, geometry, and forward pass are recorded and submitted sorted by pass, shader, material, and vertex array with the next call of flushRenderQueue. Pending requests are flushed on pass changes as well. Multiple requests of the same instancing capable actor are coalesced into a single instanced draw call.
+		*/
+		void enableRenderQueue(bool Enable);
+		bool renderQueueEnabled(void)const;
+		void flushRenderQueue(void);
+
 		void activeShader(GLShader* pShader);
 		void activeMaterial(RenderMaterial* pMaterial);
 		void activeCamera(VirtualCamera* pCamera);
@@ -101,6 +111,12 @@ namespace CForge {
 		RenderMaterial* activeMaterial(void)const;
 		VirtualCamera* activeCamera(void)const;
 
+		/**
+		* \brief Frustum to cull against in the active pass. The view frustum of the active shadow casting light during the shadow pass, the active camera's view frustum otherwise.
+		* \return Frustum or nullptr if there is nothing to cull against.
+		*/
+		const ViewFrustum* cullingFrustum(void)const;
+
 		UBOCameraData* cameraUBO(void);
 		UBOModelData* modelUBO(void);
 		UBOLightData* lightsUBO(void);
@@ -128,6 +144,10 @@ namespace CForge {
 		};
 
 		void updateMaterial(void);
+		void updateModelData(const Eigen::Quaternionf Rotation, const Eigen::Vector3f Translation, const Eigen::Vector3f Scale);
+		void queuedModelData(uint32_t TransformIndex);
+		void bindModelData(void);
+		void enqueueRendering(IRenderableActor* pActor, const Eigen::Quaternionf Rotation, const Eigen::Vector3f Translation, const Eigen::Vector3f Scale);
 		void addLight(ILight *pLight, std::vector<ActiveLight*>* pLights);
 
 		// settings for current rendering
@@ -158,6 +178,15 @@ namespace CForge {
 		Viewport m_Viewport[RENDERPASS_COUNT];
 
 		ActiveLight* m_pActiveShadowLight;
+		ViewFrustum m_ShadowFrustum; ///< View frustum of the active shadow casting light
+
+		RenderQueue m_RenderQueue;
+		bool m_RenderQueueEnabled;
+		bool m_FlushingRenderQueue;
+		std::vector<uint32_t> m_QueuedInstances; ///< transformation indices currently stored in an actor's instance buffer
+		std::vector<Eigen::Matrix4f> m_InstanceMatrices;
+		uint32_t m_QueueModelSlot; ///< first model data slot of the queue's transformations
+		uint32_t m_QueueWrapCount;
 	private:
 
 	};//RenderDevice
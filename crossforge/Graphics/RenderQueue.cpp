@@ -0,0 +1,105 @@
+#include <cstring>
+#include "RenderQueue.h"
+
+namespace CForge {
+
+	uint64_t RenderQueue::sortKey(int32_t Pass, uint32_t ShaderID, uint32_t MaterialID, uint32_t VertexArrayID, uint32_t RenderGroup) {
+		uint64_t Rval = 0;
+		Rval |= (uint64_t(Pass + 1) & 0xF) << 60;
+		Rval |= (uint64_t(ShaderID) & 0xFFFF) << 44;
+		Rval |= (uint64_t(MaterialID) & 0xFFFF) << 28;
+		Rval |= (uint64_t(VertexArrayID) & 0xFFFF) << 12;
+		Rval |= (uint64_t(RenderGroup) & 0xFFF);
+		return Rval;
+	}//sortKey
+
+	RenderQueue::RenderQueue(void): CForgeObject("RenderQueue") {
+
+	}//Constructor
+
+	RenderQueue::~RenderQueue(void) {
+		clear();
+	}//Destructor
+
+	void RenderQueue::init(void) {
+		clear();
+	}//initialize
+
+	void RenderQueue::clear(void) {
+		// keep the capacity, the queue gets refilled every frame
+		m_Items.clear();
+		m_Transforms.clear();
+		m_Order.clear();
+	}//clear
+
+	uint32_t RenderQueue::addTransform(const Eigen::Quaternionf Rotation, const Eigen::Vector3f Translation, const Eigen::Vector3f Scale) {
+		Transform T;
+		T.Rotation = Rotation;
+		T.Translation = Translation;
+		T.Scale = Scale;
+		m_Transforms.push_back(T);
+		return uint32_t(m_Transforms.size() - 1);
+	}//addTransform
+
+	void RenderQueue::addItem(IRenderableActor* pActor, int32_t RenderGroup, uint32_t TransformIndex, uint64_t SortKey) {
+		if (nullptr == pActor) throw NullpointerExcept("pActor");
+		if (TransformIndex >= m_Transforms.size()) throw IndexOutOfBoundsExcept("TransformIndex");
+
+		Item I;
+		I.pActor = pActor;
+		I.RenderGroup = RenderGroup;
+		I.TransformIndex = TransformIndex;
+		I.SortKey = SortKey;
+		m_Items.push_back(I);
+		m_Order.push_back(uint32_t(m_Items.size() - 1));
+	}//addItem
+
+	void RenderQueue::sort(void) {
+		const uint32_t Count = uint32_t(m_Order.size());
+		if (Count < 2) return;
+
+		// least significant digit radix sort with 8 bit digits, stable, so equal keys keep submission order
+		m_Swap.resize(Count);
+		uint32_t Histogram[256];
+
+		for (uint32_t Shift = 0; Shift < 64; Shift += 8) {
+			memset(Histogram, 0, sizeof(Histogram));
+			for (uint32_t i = 0; i < Count; ++i) Histogram[(m_Items[m_Order[i]].SortKey >> Shift) & 0xFF]++;
+
+			// all keys share this digit, nothing to do
+			if (Histogram[(m_Items[m_Order[0]].SortKey >> Shift) & 0xFF] == Count) continue;
+
+			uint32_t Offset = 0;
+			for (uint32_t i = 0; i < 256; ++i) {
+				const uint32_t C = Histogram[i];
+				Histogram[i] = Offset;
+				Offset += C;
+			}//for[buckets]
+
+			for (uint32_t i = 0; i < Count; ++i) {
+				const uint32_t Digit = (m_Items[m_Order[i]].SortKey >> Shift) & 0xFF;
+				m_Swap[Histogram[Digit]++] = m_Order[i];
+			}//for[items]
+			std::swap(m_Order, m_Swap);
+		}//for[digits]
+	}//sort
+
+	uint32_t RenderQueue::size(void)const {
+		return uint32_t(m_Order.size());
+	}//size
+
+	uint32_t RenderQueue::transformCount(void)const {
+		return uint32_t(m_Transforms.size());
+	}//transformCount
+
+	const RenderQueue::Item* RenderQueue::item(uint32_t Index)const {
+		if (Index >= m_Order.size()) throw IndexOutOfBoundsExcept("Index");
+		return &m_Items[m_Order[Index]];
+	}//item
+
+	const RenderQueue::Transform* RenderQueue::transform(uint32_t Index)const {
+		if (Index >= m_Transforms.size()) throw IndexOutOfBoundsExcept("Index");
+		return &m_Transforms[Index];
+	}//transform
+
+}//name space
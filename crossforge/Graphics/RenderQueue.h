@@ -0,0 +1,75 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): RenderQueue.h and RenderQueue.cpp                                *
+*                                                                           *
+* Content: Collects draw requests of a frame and sorts them by a state key  *
+*          to reduce shader, material, and vertex array switches.          *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_RENDERQUEUE_H__
+#define __CFORGE_RENDERQUEUE_H__
+
+#include "../Core/CForgeObject.h"
+
+namespace CForge {
+	class IRenderableActor;
+
+	/**
+	* \brief Deferred list of draw requests. Items are recorded during scene traversal, sorted by a 64 bit state key using a radix sort and submitted afterwards by the render device.
+	*
+	* Sort key layout (most significant first): render pass (4 bits), shader (16 bits), material (16 bits), vertex array (16 bits), render group (12 bits). Object identifiers are truncated to 16 bits. Collisions only cost additional state changes, never correctness.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API RenderQueue : public CForgeObject {
+	public:
+		struct Transform {
+			Eigen::Quaternionf Rotation;
+			Eigen::Vector3f Translation;
+			Eigen::Vector3f Scale;
+		};
+
+		struct Item {
+			IRenderableActor* pActor;	///< Actor to render.
+			int32_t RenderGroup;		///< Render group of the actor or -1 if the whole actor has to be rendered.
+			uint32_t TransformIndex;	///< Index of the world transformation.
+			uint64_t SortKey;			///< State key used for sorting.
+		};
+
+		static uint64_t sortKey(int32_t Pass, uint32_t ShaderID, uint32_t MaterialID, uint32_t VertexArrayID, uint32_t RenderGroup);
+
+		RenderQueue(void);
+		~RenderQueue(void);
+
+		void init(void);
+		void clear(void);
+
+		uint32_t addTransform(const Eigen::Quaternionf Rotation, const Eigen::Vector3f Translation, const Eigen::Vector3f Scale);
+		void addItem(IRenderableActor* pActor, int32_t RenderGroup, uint32_t TransformIndex, uint64_t SortKey);
+
+		void sort(void);
+
+		uint32_t size(void)const;
+		uint32_t transformCount(void)const;
+		const Item* item(uint32_t Index)const;
+		const Transform* transform(uint32_t Index)const;
+
+	protected:
+		std::vector<Item> m_Items;
+		std::vector<Transform> m_Transforms;
+		std::vector<uint32_t> m_Order; ///< Item indices in sorted order.
+		std::vector<uint32_t> m_Swap; ///< Scratch buffer for the radix sort.
+	};//RenderQueue
+
+}//name space
+
+#endif
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include "ISceneGraphNode.h"
 
+using namespace Eigen;
+
 namespace CForge {
 
 	ISceneGraphNode::ISceneGraphNode(const std::string ClassName): CForgeObject("ISceneGraphNode::" + ClassName) {
@@ -7,6 +10,20 @@ namespace CForge {
 		m_Children.clear();
 		m_UpdateEnabled = true;
 		m_RenderingEnabled = true;
+		m_RenderingRequested = true;
+		m_DeferStateChanges = false;
+		m_WorldTranslation = Vector3f::Zero();
+		m_WorldRotation = Quaternionf::Identity();
+		m_WorldScale = Vector3f::Ones();
+		m_ParentTranslation = Vector3f::Zero();
+		m_ParentRotation = Quaternionf::Identity();
+		m_ParentScale = Vector3f::Ones();
+		m_TransformationDirty = true;
+		m_WorldBounds.setEmpty();
+		m_BoundsValid = false;
+		m_BoundsTranslation = Vector3f::Zero();
+		m_BoundsRotation = Quaternionf::Identity();
+		m_BoundsScale = Vector3f::Ones();
 	}//Constructor
 
 	ISceneGraphNode::~ISceneGraphNode(void) {
@@ -14,11 +31,17 @@ namespace CForge {
 	}//Destructor
 
 
+	bool ISceneGraphNode::updateNode(float FPSScale) {
+		update(FPSScale);
+		return false;
+	}//updateNode
+
 	void ISceneGraphNode::init(ISceneGraphNode* pParent) {
 		clear();
 		parent(pParent);
 		m_UpdateEnabled = true;
 		m_RenderingEnabled = true;
+		m_RenderingRequested = true;
 	}//initialize
 
 	void ISceneGraphNode::clear(void) {
@@ -29,17 +52,18 @@ namespace CForge {
 		m_pParent = nullptr;
 		m_UpdateEnabled = true;
 		m_RenderingEnabled = true;
+		m_RenderingRequested = true;
+		m_DeferStateChanges = false;
+		m_TransformationDirty = true;
+		m_WorldBounds.setEmpty();
+		m_BoundsValid = false;
 	}//clear
 
 	void ISceneGraphNode::parent(ISceneGraphNode* pNode) {
 		if (pNode == m_pParent) return; // nothing to do
-		if (m_pParent != nullptr) {
-			m_pParent->removeChild(this);
-			m_pParent = nullptr;
-		}
-
-		m_pParent = pNode;
-		if(nullptr != m_pParent) m_pParent->addChild(this);
+		// both calls maintain the parent pointer
+		if (nullptr != m_pParent) m_pParent->removeChild(this);
+		if (nullptr != pNode) pNode->addChild(this);
 	}//parent
 
 	ISceneGraphNode* ISceneGraphNode::parent(void)const {
@@ -50,38 +74,37 @@ namespace CForge {
 		if (nullptr == pNode) throw NullpointerExcept("PNode");
 
 		if (isChild(pNode)) return; // node is already child of this node
+		if (nullptr != pNode->m_pParent) pNode->m_pParent->removeChild(pNode);
 
 		m_Children.push_back(pNode);
-		pNode->parent(this);
+		pNode->m_pParent = this;
+		pNode->deferStateChanges(m_DeferStateChanges);
+		pNode->invalidateTransformation();
+		invalidateBounds();
 	}//addChild
 
 	void ISceneGraphNode::removeChild(ISceneGraphNode* pNode) {
 		if (nullptr == pNode) throw NullpointerExcept("pNode");
 		if (!isChild(pNode)) return;
 
-		m_Children.remove(pNode);
-		pNode->parent(nullptr);
-
+		m_Children.erase(std::find(m_Children.begin(), m_Children.end(), pNode));
+		pNode->m_pParent = nullptr;
+		pNode->invalidateTransformation();
+		invalidateBounds();
 	}//removeChild
 
 	void ISceneGraphNode::removeAllChildren(void) {
-		std::vector<ISceneGraphNode*> NodesToRemove;
-		for (auto i : m_Children) NodesToRemove.push_back(i);
+		for (auto i : m_Children) {
+			i->m_pParent = nullptr;
+			i->invalidateTransformation();
+		}
 		m_Children.clear();
-
-		for (auto i : NodesToRemove) i->parent(nullptr);
+		invalidateBounds();
 	}//removeAllChildren
 
 	bool ISceneGraphNode::isChild(const ISceneGraphNode* pNode)const {
-		if (nullptr == pNode) return false;
-		bool Rval = false;
-		for (auto i : m_Children) {
-			if (pNode == i) {
-				Rval = true;
-				break;
-			}
-		}//for[all child nodes]
-		return Rval;
+		// parent pointer and child list are kept consistent, no need to search
+		return (nullptr != pNode && pNode->m_pParent == this);
 	}//isChild
 
 	uint32_t ISceneGraphNode::childCount(void)const {
@@ -89,20 +112,118 @@ namespace CForge {
 	}//childCount
 
 	ISceneGraphNode* ISceneGraphNode::child(uint32_t Index) {
-		if (Index > m_Children.size()) throw IndexOutOfBoundsExcept("Index");
-		auto Node = m_Children.begin();
-		for (uint32_t i = 0; i < Index; ++i, ++Node);
-		return (*Node);
+		if (Index >= m_Children.size()) throw IndexOutOfBoundsExcept("Index");
+		return m_Children[Index];
 	}//child
 
 	void ISceneGraphNode::enable(bool Update, bool Rendering) {
 		m_UpdateEnabled = Update;
-		m_RenderingEnabled = Rendering;
+		m_RenderingRequested = Rendering;
+		if (!m_DeferStateChanges) ISceneGraphNode::publishState();
 	}//enable
 
 	void ISceneGraphNode::enabled(bool* pUpdate, bool* pRendering) {
 		if (nullptr != pUpdate) (*pUpdate) = m_UpdateEnabled;
-		if (nullptr != pRendering) (*pRendering) = m_RenderingEnabled;
+		if (nullptr != pRendering) (*pRendering) = m_RenderingRequested;
 	}//enabled
 
+	void ISceneGraphNode::deferStateChanges(bool Enable) {
+		m_DeferStateChanges = Enable;
+		// pending changes must not get lost
+		if (!Enable) publishState();
+		for (auto i : m_Children) i->deferStateChanges(Enable);
+	}//deferStateChanges
+
+	bool ISceneGraphNode::deferStateChanges(void)const {
+		return m_DeferStateChanges;
+	}//deferStateChanges
+
+	void ISceneGraphNode::commitState(void) {
+		publishState();
+		for (auto i : m_Children) i->commitState();
+	}//commitState
+
+	void ISceneGraphNode::publishState(void) {
+		if (m_RenderingEnabled == m_RenderingRequested) return;
+		m_RenderingEnabled = m_RenderingRequested;
+		// disabled nodes are not part of the parent's bounds, so the parent may be valid although this node is not
+		m_BoundsValid = false;
+		if (nullptr != m_pParent) m_pParent->invalidateBounds();
+	}//publishState
+
+	void ISceneGraphNode::invalidateBounds(void) {
+		// ancestors of outdated nodes are outdated as well, so we can stop at the first one
+		ISceneGraphNode* pNode = this;
+		while (nullptr != pNode && pNode->m_BoundsValid.exchange(false)) {
+			pNode = pNode->m_pParent;
+		}
+	}//invalidateBounds
+
+	bool ISceneGraphNode::worldBounds(Eigen::AlignedBox3f* pBounds)const {
+		if (nullptr != pBounds) (*pBounds) = m_WorldBounds;
+		return m_BoundsValid;
+	}//worldBounds
+
+	void ISceneGraphNode::invalidateTransformation(void) {
+		// clean nodes have clean ancestors, so descendants of a dirty node are dirty already
+		if (m_TransformationDirty) return;
+		m_TransformationDirty = true;
+		for (auto i : m_Children) i->invalidateTransformation();
+	}//invalidateTransformation
+
+	bool ISceneGraphNode::transformationCached(const Eigen::Vector3f& ParentTranslation, const Eigen::Quaternionf& ParentRotation, const Eigen::Vector3f& ParentScale)const {
+		if (m_TransformationDirty) return false;
+		return (ParentTranslation == m_ParentTranslation && ParentRotation.coeffs() == m_ParentRotation.coeffs() && ParentScale == m_ParentScale);
+	}//transformationCached
+
+	void ISceneGraphNode::cacheTransformation(const Eigen::Vector3f& ParentTranslation, const Eigen::Quaternionf& ParentRotation, const Eigen::Vector3f& ParentScale, const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale) {
+		m_ParentTranslation = ParentTranslation;
+		m_ParentRotation = ParentRotation;
+		m_ParentScale = ParentScale;
+		m_WorldTranslation = Translation;
+		m_WorldRotation = Rotation;
+		m_WorldScale = Scale;
+		m_TransformationDirty = false;
+	}//cacheTransformation
+
+	bool ISceneGraphNode::cullSubtree(RenderDevice* pRDev, const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale)const {
+		if (!m_BoundsValid) return false;
+		if (Translation != m_BoundsTranslation || Rotation.coeffs() != m_BoundsRotation.coeffs() || Scale != m_BoundsScale) return false;
+		if (m_WorldBounds.isEmpty()) return true; // nothing to render
+
+		const ViewFrustum* pFrustum = pRDev->cullingFrustum();
+		if (nullptr == pFrustum) return false;
+		Box AABB;
+		AABB.init(m_WorldBounds.min(), m_WorldBounds.max());
+		return !pFrustum->visible(AABB, Quaternionf::Identity(), Vector3f::Zero(), Vector3f::Ones());
+	}//cullSubtree
+
+	void ISceneGraphNode::cacheBounds(const Eigen::AlignedBox3f& Bounds, bool Valid, const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale) {
+		m_WorldBounds = Bounds;
+		m_BoundsValid = Valid;
+		m_BoundsTranslation = Translation;
+		m_BoundsRotation = Rotation;
+		m_BoundsScale = Scale;
+	}//cacheBounds
+
+	void ISceneGraphNode::cacheChildBounds(const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale) {
+		AlignedBox3f Bounds;
+		Bounds.setEmpty();
+		bool Valid = true;
+
+		for (auto i : m_Children) {
+			// published flag, enabled() reports the simulated one
+			if (!i->m_RenderingEnabled) continue;
+
+			AlignedBox3f ChildBounds;
+			if (!i->worldBounds(&ChildBounds)) {
+				Valid = false;
+				break;
+			}
+			Bounds.extend(ChildBounds);
+		}//for[children]
+
+		cacheBounds(Bounds, Valid, Translation, Rotation, Scale);
+	}//cacheChildBounds
+
 }//name space
\ No newline at end of file
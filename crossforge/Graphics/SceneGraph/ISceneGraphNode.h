@@ -19,7 +19,8 @@
 #define __CFORGE_ISCENEGRAPHNODE_H__
 
 
-#include <list>
+#include <vector>
+#include <atomic>
 #include "../../Core/CForgeObject.h"
 #include "../RenderDevice.h"
 
@@ -27,15 +28,25 @@ namespace CForge {
 	/**
 	* \brief Interface class of all scene graph nodes. Implements the basic tree operations.
 	*
+	* Every node caches its world transformation. Changing a local transformation or the parent marks the node and its descendants dirty, clean nodes reuse the cache during rendering and answer world pose queries in constant time.
+	*
+	* Every node caches a world space box of its subtree during rendering, so the next traversal can reject the whole subtree with a single frustum test. The cache is only used if the node receives the same transformation again. Changes to a node mark it and its ancestors outdated.
+	*
 	* \todo Do full documentation.
 	*/
 	class CFORGE_API ISceneGraphNode: public CForgeObject {
 	public:
 
 		virtual void update(float FPSScale) = 0;
+
+		/**
+		* \brief Updates this node only, so a caller can distribute the subtrees over several threads. The default performs the full update.
+		* \return True if the caller still has to update the children.
+		*/
+		virtual bool updateNode(float FPSScale);
 		virtual void render(RenderDevice *pRDev, const Eigen::Vector3f Position, const Eigen::Quaternionf Rotation, const Eigen::Vector3f Scale) = 0;
 
-		// builds transformation recursively the tree up to root
+		// world transformation of the node, recomputed the tree up to root only where local transformations changed
 		virtual void buildTansformation(Eigen::Vector3f* pPosition, Eigen::Quaternionf* pRotation, Eigen::Vector3f* pScale) = 0;
 
 		virtual void init(ISceneGraphNode* pParent = nullptr);
@@ -50,17 +61,77 @@ namespace CForge {
 		virtual uint32_t childCount(void)const;
 		virtual ISceneGraphNode* child(uint32_t Index);
 
+		/**
+		* \brief Enables updating and rendering of this subtree. The rendering flag is state of the node and gets deferred like other state changes, see deferStateChanges.
+		*/
 		virtual void enable(bool Update, bool Rendering);
 		virtual void enabled(bool* pUpdate, bool* pRendering);
 
+		/**
+		* \brief Marks the cached bounds of this node and all ancestors outdated. Happens automatically if transformations, children, actors or enable states change. Volume changes of actors (see IRenderableActor::boundingVolumeVersion) are noticed by SGNGeometry during update.
+		*/
+		virtual void invalidateBounds(void);
+
+		/**
+		* \brief World space box enclosing the geometry of this subtree, determined during the last render traversal.
+		* \param[out] pBounds Cached box. Empty if the subtree contains no geometry.
+		* \return False if no valid bounds are cached, e.g. because the subtree contains geometry with unknown or dynamic bounding volume.
+		*/
+		bool worldBounds(Eigen::AlignedBox3f* pBounds)const;
+
+		/**
+		* \brief Defers state changes of this subtree until commitState, so a simulation thread can update while the render thread draws the committed state. State are the local transformations of SGNTransformation and SGNGeometry, the actor of SGNGeometry, and the rendering flag (see enable). Getters return the simulated state. New children take over the setting of their parent. World transformations (buildTansformation) and bounds belong to the render side.
+		*/
+		void deferStateChanges(bool Enable);
+		bool deferStateChanges(void)const;
+
+		/**
+		* \brief Publishes deferred state changes of this subtree for rendering. Call while the subtree is not updated, e.g. at the fence of SimulationThread.
+		*/
+		void commitState(void);
+
 	protected:
 		ISceneGraphNode(const std::string ClassName);
 		~ISceneGraphNode(void);
 
-		std::list<ISceneGraphNode*> m_Children; ///< child nodes
+		/**
+		* \brief Tests the cached bounds against the culling frustum of the render device.
+		* \return True if the subtree can be skipped. Outdated bounds or a different transformation never cull.
+		*/
+		bool cullSubtree(RenderDevice* pRDev, const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale)const;
+		void cacheBounds(const Eigen::AlignedBox3f& Bounds, bool Valid, const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale);
+		/**
+		* \brief Marks the cached world transformation of this node and all descendants outdated.
+		*/
+		void invalidateTransformation(void);
+		bool transformationCached(const Eigen::Vector3f& ParentTranslation, const Eigen::Quaternionf& ParentRotation, const Eigen::Vector3f& ParentScale)const; ///< Whether the cache is clean and was built from the specified parent transformation.
+		void cacheTransformation(const Eigen::Vector3f& ParentTranslation, const Eigen::Quaternionf& ParentRotation, const Eigen::Vector3f& ParentScale, const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale);
+
+		virtual void publishState(void); ///< Publishes deferred state changes of this node only. Overrides have to call the base implementation.
+
+		void cacheChildBounds(const Eigen::Vector3f& Translation, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Scale); ///< Merges the bounds of all enabled children, call after the children were rendered.
+
+		std::vector<ISceneGraphNode*> m_Children; ///< child nodes
 		ISceneGraphNode* m_pParent; ///< Parent node
 		bool m_UpdateEnabled;
-		bool m_RenderingEnabled;
+		bool m_RenderingEnabled; ///< Published rendering flag
+		bool m_RenderingRequested; ///< Simulated rendering flag, see enable
+
+		bool m_DeferStateChanges;
+
+		Eigen::Vector3f m_WorldTranslation; ///< Cached world transformation
+		Eigen::Quaternionf m_WorldRotation;
+		Eigen::Vector3f m_WorldScale;
+		Eigen::Vector3f m_ParentTranslation; ///< Parent world transformation the cache was built from
+		Eigen::Quaternionf m_ParentRotation;
+		Eigen::Vector3f m_ParentScale;
+		bool m_TransformationDirty; ///< Only marked within the own subtree, so no concurrent access during parallel updates
+
+		Eigen::AlignedBox3f m_WorldBounds; ///< World space bounds of the subtree
+		std::atomic<bool> m_BoundsValid; ///< Invalidated concurrently by subtrees updated on different threads
+		Eigen::Vector3f m_BoundsTranslation; ///< Transformation the node received when the bounds were cached
+		Eigen::Quaternionf m_BoundsRotation;
+		Eigen::Vector3f m_BoundsScale;
 
 	};
 
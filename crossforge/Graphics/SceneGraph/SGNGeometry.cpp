@@ -9,6 +9,12 @@ namespace CForge {
 		m_Rotation = Quaternionf::Identity();
 		m_Scale = Vector3f::Ones();
 		m_pRenderable = nullptr;
+		m_RenderPosition = Vector3f::Zero();
+		m_RenderRotation = Quaternionf::Identity();
+		m_RenderScale = Vector3f::Ones();
+		m_pRenderActor = nullptr;
+		m_StateChanged = false;
+		m_ActorBVVersion = 0;
 		m_VisualizationMode = VISUALIZATION_FILL;
 	}//Constructor
 
@@ -32,22 +38,31 @@ namespace CForge {
 		m_Rotation = Quaternionf::Identity();
 		m_Scale = Vector3f::Ones();
 		m_pRenderable = nullptr;
+		m_RenderPosition = Vector3f::Zero();
+		m_RenderRotation = Quaternionf::Identity();
+		m_RenderScale = Vector3f::Ones();
+		m_pRenderActor = nullptr;
+		m_StateChanged = false;
 	}//clear
 
 	void SGNGeometry::position(Eigen::Vector3f Position) {
 		m_Position = Position;
+		stateChanged();
 	}//position
 
 	void SGNGeometry::rotation(Eigen::Quaternionf Rotation) {
 		m_Rotation = Rotation;
+		stateChanged();
 	}//rotation
 
 	void SGNGeometry::scale(Eigen::Vector3f Scale) {
 		m_Scale = Scale;
+		stateChanged();
 	}//scale
 
 	void SGNGeometry::actor(IRenderableActor* pActor) {
 		m_pRenderable = pActor;
+		stateChanged();
 	}//actor
 
 	Eigen::Vector3f SGNGeometry::position(void)const {
@@ -67,18 +82,36 @@ namespace CForge {
 	}//actor
 
 	void SGNGeometry::update(float FPSScale) {
-		// nothing to do here
+		// actors do not know the nodes they are attached to, so volume changes (e.g. new instances) are noticed here
+		if (nullptr != m_pRenderActor && m_pRenderActor->boundingVolumeVersion() != m_ActorBVVersion) invalidateBounds();
 	}//update
 
 	void SGNGeometry::render(RenderDevice* pRDev, const Eigen::Vector3f Position, const Eigen::Quaternionf Rotation, const Eigen::Vector3f Scale) {
-		if (nullptr != m_pRenderable && m_RenderingEnabled) {
-			const Eigen::Vector3f Pos = Position + m_Position;
-			const Eigen::Quaternionf Rot = Rotation * m_Rotation;
-			const Eigen::Vector3f S = m_Scale.cwiseProduct(Scale);
-
-			const BoundingVolume BV = m_pRenderable->boundingVolume();
-
-			if (BV.type() == BoundingVolume::TYPE_UNKNOWN || pRDev->activeCamera()->viewFrustum()->visible(BV, Rot, Pos, S)) {
+		if (nullptr == m_pRenderActor && m_RenderingEnabled) {
+			AlignedBox3f Empty;
+			Empty.setEmpty();
+			cacheBounds(Empty, true, Position, Rotation, Scale);
+		}
+		else if (nullptr != m_pRenderActor && m_RenderingEnabled) {
+			if (!transformationCached(Position, Rotation, Scale)) {
+				cacheTransformation(Position, Rotation, Scale, Position + m_RenderPosition, Rotation * m_RenderRotation, m_RenderScale.cwiseProduct(Scale));
+			}
+			const Eigen::Vector3f Pos = m_WorldTranslation;
+			const Eigen::Quaternionf Rot = m_WorldRotation;
+			const Eigen::Vector3f S = m_WorldScale;
+
+			m_ActorBVVersion = m_pRenderActor->boundingVolumeVersion();
+			const BoundingVolume BV = m_pRenderActor->boundingVolume();
+
+			// bounds for hierarchical culling, actors with unknown or changing volumes can not be cached
+			AlignedBox3f Bounds;
+			Bounds.setEmpty();
+			if (BV.type() != BoundingVolume::TYPE_UNKNOWN) worldBox(BV, Rot, Pos, S, &Bounds);
+			cacheBounds(Bounds, BV.type() != BoundingVolume::TYPE_UNKNOWN && !m_pRenderActor->dynamicBoundingVolume(), Position, Rotation, Scale);
+
+			// light frustum during the shadow pass
+			const ViewFrustum* pFrustum = pRDev->cullingFrustum();
+			if (BV.type() == BoundingVolume::TYPE_UNKNOWN || nullptr == pFrustum || pFrustum->visible(BV, Rot, Pos, S)) {
 #				ifndef __EMSCRIPTEN__
 				if (m_VisualizationMode != VISUALIZATION_FILL) {
 					switch (m_VisualizationMode) {
@@ -89,15 +122,19 @@ namespace CForge {
 					}break;
 					}
 					glDisable(GL_CULL_FACE);
-					pRDev->requestRendering(m_pRenderable, Rot, Pos, S);
+					// polygon mode only holds for this request, so bypass the render queue
+					const bool Queued = pRDev->renderQueueEnabled();
+					pRDev->enableRenderQueue(false);
+					pRDev->requestRendering(m_pRenderActor, Rot, Pos, S);
+					pRDev->enableRenderQueue(Queued);
 					glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 					glEnable(GL_CULL_FACE);
 				}
 				else {
-					pRDev->requestRendering(m_pRenderable, Rot, Pos, S);
+					pRDev->requestRendering(m_pRenderActor, Rot, Pos, S);
 				}		
 				#else			
-					pRDev->requestRendering(m_pRenderable, Rot, Pos, S);
+					pRDev->requestRendering(m_pRenderActor, Rot, Pos, S);
 				#endif
 			}
 				
@@ -106,18 +143,55 @@ namespace CForge {
 	}//render
 
 	void SGNGeometry::buildTansformation(Eigen::Vector3f* pPosition, Eigen::Quaternionf* pRotation, Eigen::Vector3f* pScale) {
-		Vector3f ParentPosition = Eigen::Vector3f::Zero();
-		Quaternionf ParentRotation = Eigen::Quaternionf::Identity();
-		Vector3f ParentScale = Eigen::Vector3f::Ones();
+		if (m_TransformationDirty) {
+			Vector3f ParentPosition = Eigen::Vector3f::Zero();
+			Quaternionf ParentRotation = Eigen::Quaternionf::Identity();
+			Vector3f ParentScale = Eigen::Vector3f::Ones();
 
-		if (nullptr != m_pParent) m_pParent->buildTansformation(&ParentPosition, &ParentRotation, &ParentScale);
+			if (nullptr != m_pParent) m_pParent->buildTansformation(&ParentPosition, &ParentRotation, &ParentScale);
+			cacheTransformation(ParentPosition, ParentRotation, ParentScale, ParentPosition + m_RenderPosition, ParentRotation * m_RenderRotation, m_RenderScale.cwiseProduct(ParentScale));
+		}
 
-		if (nullptr != pPosition) (*pPosition) = ParentPosition + m_Position;
-		if (nullptr != pRotation) (*pRotation) = ParentRotation * m_Rotation;
-		if (nullptr != pScale) (*pScale) = m_Scale.cwiseProduct(ParentScale);
+		if (nullptr != pPosition) (*pPosition) = m_WorldTranslation;
+		if (nullptr != pRotation) (*pRotation) = m_WorldRotation;
+		if (nullptr != pScale) (*pScale) = m_WorldScale;
 
 	}//buildTransformation
 
+	void SGNGeometry::stateChanged(void) {
+		m_StateChanged = true;
+		if (!m_DeferStateChanges) publishState();
+	}//stateChanged
+
+	void SGNGeometry::publishState(void) {
+		ISceneGraphNode::publishState();
+		if (!m_StateChanged) return;
+		m_RenderPosition = m_Position;
+		m_RenderRotation = m_Rotation;
+		m_RenderScale = m_Scale;
+		m_pRenderActor = m_pRenderable;
+		m_StateChanged = false;
+		invalidateTransformation();
+		invalidateBounds();
+	}//publishState
+
+	void SGNGeometry::worldBox(const BoundingVolume& BV, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Position, const Eigen::Vector3f& Scale, Eigen::AlignedBox3f* pBounds)const {
+		if (BV.type() == BoundingVolume::TYPE_SPHERE) {
+			const Sphere BS = BV.boundingSphere();
+			const Vector3f Center = Rotation * Scale.cwiseProduct(BS.center()) + Position;
+			const Vector3f Radius = Vector3f::Constant(BS.radius() * Scale.cwiseAbs().maxCoeff());
+			pBounds->extend(Center - Radius);
+			pBounds->extend(Center + Radius);
+		}
+		else {
+			// all eight corners, the box is not axis aligned after rotation
+			const AlignedBox3f Local(BV.aabb().min(), BV.aabb().max());
+			for (uint8_t i = 0; i < 8; ++i) {
+				pBounds->extend(Rotation * Scale.cwiseProduct(Local.corner(AlignedBox3f::CornerType(i))) + Position);
+			}
+		}
+	}//worldBox
+
 	void SGNGeometry::visualization(Visualization Mode) {
 		m_VisualizationMode = Mode;
 	}//visualization
@@ -26,6 +26,8 @@ namespace CForge {
 	/**
 	* \brief Geometry scene graph node.
 	*
+	* Setters change the simulated placement and actor, rendering uses the published ones. Both are the same unless state changes are deferred, see ISceneGraphNode::deferStateChanges.
+	*
 	* \todo Do full documentation.
 	*/
 	class CFORGE_API SGNGeometry : public ISceneGraphNode {
@@ -60,11 +62,22 @@ namespace CForge {
 		virtual Visualization visualization(void)const;
 
 	protected:
+		void stateChanged(void);
+		void publishState(void);
+		void worldBox(const BoundingVolume& BV, const Eigen::Quaternionf& Rotation, const Eigen::Vector3f& Position, const Eigen::Vector3f& Scale, Eigen::AlignedBox3f* pBounds)const;
+
 		Eigen::Vector3f m_Position;
 		Eigen::Quaternionf m_Rotation;
 		Eigen::Vector3f m_Scale;
 		IRenderableActor* m_pRenderable;
 
+		Eigen::Vector3f m_RenderPosition; ///< Published placement and actor used for rendering
+		Eigen::Quaternionf m_RenderRotation;
+		Eigen::Vector3f m_RenderScale;
+		IRenderableActor* m_pRenderActor;
+		bool m_StateChanged;
+		std::atomic<uint32_t> m_ActorBVVersion; ///< Bounding volume version of the actor when the bounds were cached
+
 		Visualization m_VisualizationMode;
 	};//SGNGeometry
 
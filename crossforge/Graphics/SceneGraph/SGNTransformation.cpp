@@ -1,9 +1,21 @@
+#include <cmath>
+#include <algorithm>
 #include "SGNTransformation.h"
 
 using namespace Eigen;
 
 namespace CForge {
 
+	// Q^Exponent along the shortest arc, same path slerp takes
+	static Quaternionf rotationPower(const Quaternionf& Q, float Exponent) {
+		Quaternionf D = Q.normalized();
+		if (D.w() < 0.0f) D.coeffs() *= -1.0f;
+		const float HalfAngle = std::acos(std::min(1.0f, D.w()));
+		const float SinHalfAngle = std::sin(HalfAngle);
+		if (SinHalfAngle < 1e-7f) return Quaternionf::Identity();
+		return Quaternionf(AngleAxisf(2.0f * HalfAngle * Exponent, D.vec() / SinHalfAngle));
+	}//rotationPower
+
 	SGNTransformation::SGNTransformation(void): ISceneGraphNode("SGNTransformation") {
 		m_Translation = Vector3f::Zero();
 		m_Rotation = Quaternionf::Identity();
@@ -11,6 +23,10 @@ namespace CForge {
 		m_TranslationDelta = Vector3f::Zero();
 		m_RotationDelta = Quaternionf::Identity();
 		m_ScaleDelta = Vector3f::Zero();
+		m_RenderTranslation = Vector3f::Zero();
+		m_RenderRotation = Quaternionf::Identity();
+		m_RenderScale = Vector3f::Ones();
+		m_StateChanged = false;
 	}//Constructor
 
 	SGNTransformation::~SGNTransformation(void) {
@@ -36,18 +52,25 @@ namespace CForge {
 		m_TranslationDelta = Vector3f::Zero();
 		m_RotationDelta = Quaternionf::Identity();
 		m_ScaleDelta = Vector3f::Ones();
+		m_RenderTranslation = Vector3f::Zero();
+		m_RenderRotation = Quaternionf::Identity();
+		m_RenderScale = Vector3f::Ones();
+		m_StateChanged = false;
 	}//clear
 
 	void SGNTransformation::translation(Eigen::Vector3f Translation) {
 		m_Translation = Translation;
+		stateChanged();
 	}//translation
 
 	void SGNTransformation::rotation(Eigen::Quaternionf Rotation) {
 		m_Rotation = Rotation;
+		stateChanged();
 	}//rotation
 
 	void SGNTransformation::scale(Eigen::Vector3f Scale) {
 		m_Scale = Scale;
+		stateChanged();
 	}//scale
 
 	void SGNTransformation::translationDelta(Eigen::Vector3f TranslationDelta) {
@@ -87,43 +110,70 @@ namespace CForge {
 	}//scaleDelta
 
 	void SGNTransformation::update(float FPSScale) {
-		if (!m_UpdateEnabled) return;
+		if (!updateNode(FPSScale)) return;
+		for (auto &i : m_Children) i->update(FPSScale);
+	}//update
+
+	bool SGNTransformation::updateNode(float FPSScale) {
+		if (!m_UpdateEnabled) return false;
+
+		const Vector3f PrevTranslation = m_Translation;
+		const Quaternionf PrevRotation = m_Rotation;
+		const Vector3f PrevScale = m_Scale;
 
 		m_Translation += FPSScale * m_TranslationDelta;
-		float Temp = FPSScale;
-		Quaternionf TargetRot = m_Rotation;
-		while (Temp > 1.0f) {
-			TargetRot *= m_RotationDelta;
-			Temp -= 1.0f;
-		}
-		m_Rotation = TargetRot.slerp(Temp, TargetRot * m_RotationDelta);
+		// closed form for any frame scale instead of applying the delta step by step
+		if (m_RotationDelta.coeffs() != Quaternionf::Identity().coeffs()) m_Rotation = m_Rotation * rotationPower(m_RotationDelta, FPSScale);
 		m_Scale += FPSScale * m_ScaleDelta;
 
-		for (auto &i : m_Children) i->update(FPSScale);
-
-	}//update
+		if (m_Translation != PrevTranslation || m_Rotation.coeffs() != PrevRotation.coeffs() || m_Scale != PrevScale) stateChanged();
+		return true;
+	}//updateNode
 
 	void SGNTransformation::render(RenderDevice* pRDev, const Eigen::Vector3f Translation, const Eigen::Quaternionf Rotation, const Eigen::Vector3f Scale) {
 		if (m_RenderingEnabled) {
-			const Eigen::Vector3f T = Translation + Rotation * m_Translation;
-			const Eigen::Quaternionf R = Rotation * m_Rotation;
-			const Eigen::Vector3f S = Scale.cwiseProduct(m_Scale);
+			// whole subtree outside the view frustum
+			if (cullSubtree(pRDev, Translation, Rotation, Scale)) return;
 
-			for (auto &i : m_Children) i->render(pRDev, T, R, S);
+			if (!transformationCached(Translation, Rotation, Scale)) {
+				cacheTransformation(Translation, Rotation, Scale, Translation + Rotation * m_RenderTranslation, Rotation * m_RenderRotation, Scale.cwiseProduct(m_RenderScale));
+			}
+
+			for (auto &i : m_Children) i->render(pRDev, m_WorldTranslation, m_WorldRotation, m_WorldScale);
+			cacheChildBounds(Translation, Rotation, Scale);
 		}
 	}//render
 
 	void SGNTransformation::buildTansformation(Eigen::Vector3f* pPosition, Eigen::Quaternionf* pRotation, Eigen::Vector3f* pScale) {
-		Vector3f ParentPosition = Vector3f::Zero();
-		Quaternionf ParentRotation = Quaternionf::Identity();
-		Vector3f ParentScale = Vector3f::Ones();
+		if (m_TransformationDirty) {
+			Vector3f ParentPosition = Vector3f::Zero();
+			Quaternionf ParentRotation = Quaternionf::Identity();
+			Vector3f ParentScale = Vector3f::Ones();
 
-		if (nullptr != m_pParent) m_pParent->buildTansformation(&ParentPosition, &ParentRotation, &ParentScale);
+			if (nullptr != m_pParent) m_pParent->buildTansformation(&ParentPosition, &ParentRotation, &ParentScale);
+			cacheTransformation(ParentPosition, ParentRotation, ParentScale, ParentPosition + ParentRotation * m_RenderTranslation, ParentRotation * m_RenderRotation, ParentScale.cwiseProduct(m_RenderScale));
+		}
 
-		if (nullptr != pPosition) (*pPosition) = ParentPosition + ParentRotation * m_Translation;
-		if (nullptr != pRotation) (*pRotation) = ParentRotation * m_Rotation;
-		if (nullptr != pScale) (*pScale) = ParentScale.cwiseProduct(m_Scale);
+		if (nullptr != pPosition) (*pPosition) = m_WorldTranslation;
+		if (nullptr != pRotation) (*pRotation) = m_WorldRotation;
+		if (nullptr != pScale) (*pScale) = m_WorldScale;
 
 	}//buildTrnasformation
 
+	void SGNTransformation::stateChanged(void) {
+		m_StateChanged = true;
+		if (!m_DeferStateChanges) publishState();
+	}//stateChanged
+
+	void SGNTransformation::publishState(void) {
+		ISceneGraphNode::publishState();
+		if (!m_StateChanged) return;
+		m_RenderTranslation = m_Translation;
+		m_RenderRotation = m_Rotation;
+		m_RenderScale = m_Scale;
+		m_StateChanged = false;
+		invalidateTransformation();
+		invalidateBounds();
+	}//publishState
+
 }//name space
\ No newline at end of file
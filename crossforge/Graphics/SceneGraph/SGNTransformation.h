@@ -24,6 +24,8 @@ namespace CForge {
 	/**
 	* \brief Scene graph node that provides affine transformation. Can also be used to create simple continuous animations.
 	*
+	* Setters and update change the simulated transformation, rendering uses the published one. Both are the same unless state changes are deferred, see ISceneGraphNode::deferStateChanges.
+	*
 	* \todo Do full documentation.
 	*/
 	class CFORGE_API SGNTransformation : public ISceneGraphNode {
@@ -55,9 +57,14 @@ namespace CForge {
 		Eigen::Vector3f scaleDelta(void)const;
 
 		void update(float FPSScale);
+		bool updateNode(float FPSScale);
 		void render(RenderDevice* pRDev, const Eigen::Vector3f Translation, const Eigen::Quaternionf Rotation, const Eigen::Vector3f Scale);
 		void buildTansformation(Eigen::Vector3f* pPosition, Eigen::Quaternionf* pRotation, Eigen::Vector3f* pScale);
 
+	protected:
+		void stateChanged(void);
+		void publishState(void);
+
 	private:
 		Eigen::Vector3f m_Translation;
 		Eigen::Quaternionf m_Rotation;
@@ -65,6 +72,11 @@ namespace CForge {
 		Eigen::Vector3f m_TranslationDelta;
 		Eigen::Quaternionf m_RotationDelta;
 		Eigen::Vector3f m_ScaleDelta;
+
+		Eigen::Vector3f m_RenderTranslation; ///< Published transformation used for rendering
+		Eigen::Quaternionf m_RenderRotation;
+		Eigen::Vector3f m_RenderScale;
+		bool m_StateChanged;
 	};//SGNTransformation
 
 }//name space
@@ -7,6 +7,8 @@ namespace CForge {
 
 	SceneGraph::SceneGraph(void): CForgeObject("SceneGraph") {
 		m_pRoot = nullptr;
+		m_pThreadPool = nullptr;
+		m_ParallelUpdate = false;
 	}//Constructor
 
 	SceneGraph::~SceneGraph(void) {
@@ -20,6 +22,9 @@ namespace CForge {
 
 	void SceneGraph::clear(void) {
 		m_pRoot = nullptr;
+		if (nullptr != m_pThreadPool) m_pThreadPool->release();
+		m_pThreadPool = nullptr;
+		m_UpdateTasks.clear();
 	}//clear
 
 	void SceneGraph::rootNode(ISceneGraphNode* pNode) {
@@ -31,12 +36,51 @@ namespace CForge {
 	}//rootNode
 
 	void SceneGraph::update(float FPSScale) {
-		if (nullptr != m_pRoot) m_pRoot->update(FPSScale);
+		if (nullptr == m_pRoot) return;
+		if (m_ParallelUpdate && nullptr == m_pThreadPool) m_pThreadPool = SThreadPool::instance();
+		if (!m_ParallelUpdate || 0 == m_pThreadPool->workerCount()) {
+			m_pRoot->update(FPSScale);
+			return;
+		}
+
+		// expand breadth first until there are enough subtrees to keep all threads busy
+		const size_t TaskTarget = 4 * size_t(m_pThreadPool->workerCount() + 1);
+		m_UpdateTasks.clear();
+		m_UpdateTasks.push_back(m_pRoot);
+		size_t Next = 0;
+		while (Next < m_UpdateTasks.size() && m_UpdateTasks.size() - Next < TaskTarget) {
+			ISceneGraphNode* pNode = m_UpdateTasks[Next++];
+			if (!pNode->updateNode(FPSScale)) continue;
+			for (uint32_t i = 0; i < pNode->childCount(); ++i) m_UpdateTasks.push_back(pNode->child(i));
+		}//while[expanding]
+
+		// subtrees are disjoint, updates only share the bounds flags of the ancestors
+		m_pThreadPool->parallelFor(uint32_t(m_UpdateTasks.size() - Next), [&](uint32_t i) {
+			m_UpdateTasks[Next + i]->update(FPSScale);
+		});
 	}//update
 
+	void SceneGraph::deferStateChanges(bool Enable) {
+		if (nullptr != m_pRoot) m_pRoot->deferStateChanges(Enable);
+	}//deferStateChanges
+
+	void SceneGraph::commitState(void) {
+		if (nullptr != m_pRoot) m_pRoot->commitState();
+	}//commitState
+
+	void SceneGraph::parallelUpdate(bool Enable) {
+		m_ParallelUpdate = Enable;
+	}//parallelUpdate
+
+	bool SceneGraph::parallelUpdate(void)const {
+		return m_ParallelUpdate;
+	}//parallelUpdate
+
 	void SceneGraph::render(RenderDevice* pRDev) {
 		if (nullptr == pRDev) throw NullpointerExcept("pRDev");
 		if (nullptr != m_pRoot) m_pRoot->render(pRDev, Vector3f::Zero(), Quaternionf::Identity(), Vector3f(1.0f, 1.0f, 1.0f));
+		// submit requests recorded during traversal (no-op if render queue is disabled)
+		pRDev->flushRenderQueue();
 	}//render
 
 }//name space
\ No newline at end of file
@@ -20,12 +20,15 @@
 
 #include "../RenderDevice.h"
 #include "../VirtualCamera.h"
+#include "../../Core/SThreadPool.h"
 #include "ISceneGraphNode.h"
 
 namespace CForge {
 	/**
 	* \brief Scene graph.
 	*
+	* Update splits the tree into independent subtrees that are updated in parallel by SThreadPool. Nodes above those subtrees are updated first on the calling thread. Parallel update is off by default, enable it with parallelUpdate(true) once all update() overrides of the tree are thread safe.
+	*
 	* \todo Do full documentation.
 	*/
 	class CFORGE_API SceneGraph: public CForgeObject {
@@ -42,8 +45,20 @@ namespace CForge {
 		void update(float FPSScale);
 		void render(RenderDevice *pRDev);
 
+		void parallelUpdate(bool Enable);
+		bool parallelUpdate(void)const;
+
+		/**
+		* \brief Double buffers the node states, so update can run on a SimulationThread while render draws the committed state.
+		*/
+		void deferStateChanges(bool Enable);
+		void commitState(void); ///< Publishes the updated state for rendering, call at the frame fence.
+
 	protected:
 		ISceneGraphNode* m_pRoot;
+		SThreadPool* m_pThreadPool;
+		bool m_ParallelUpdate;
+		std::vector<ISceneGraphNode*> m_UpdateTasks; ///< Roots of the subtrees updated in parallel
 	};//SceneGraph
 
 }//name space
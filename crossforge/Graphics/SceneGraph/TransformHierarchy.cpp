@@ -0,0 +1,256 @@
+#include <algorithm>
+#include "TransformHierarchy.h"
+
+using namespace Eigen;
+
+namespace CForge {
+
+	// moves the range [Begin, Begin + Count) in front of Dest
+	template<typename T>
+	static void rotateRange(std::vector<T>& Data, uint32_t Begin, uint32_t Count, uint32_t Dest) {
+		if (Dest > Begin) std::rotate(Data.begin() + Begin, Data.begin() + Begin + Count, Data.begin() + Dest);
+		else std::rotate(Data.begin() + Dest, Data.begin() + Begin, Data.begin() + Begin + Count);
+	}//rotateRange
+
+	TransformHierarchy::TransformHierarchy(void): CForgeObject("TransformHierarchy") {
+
+	}//Constructor
+
+	TransformHierarchy::~TransformHierarchy(void) {
+		clear();
+	}//Destructor
+
+	void TransformHierarchy::init(void) {
+		clear();
+	}//initialize
+
+	void TransformHierarchy::clear(void) {
+		m_Parents.clear();
+		m_SubtreeSizes.clear();
+		m_NodeSlots.clear();
+		m_Translations.clear();
+		m_Rotations.clear();
+		m_Scales.clear();
+		m_WorldTranslations.clear();
+		m_WorldRotations.clear();
+		m_WorldScales.clear();
+		m_Dirty.clear();
+		m_Slots.clear();
+		m_FreeSlots.clear();
+	}//clear
+
+	TransformHierarchy::Handle TransformHierarchy::create(Handle Parent, Eigen::Vector3f Translation, Eigen::Quaternionf Rotation, Eigen::Vector3f Scale) {
+		if (Parent != Handle() && !valid(Parent)) throw CForgeExcept("Invalid parent handle!");
+
+		uint32_t SlotID = 0;
+		if (m_FreeSlots.empty()) {
+			SlotID = uint32_t(m_Slots.size());
+			m_Slots.push_back(Slot{ InvalidIndex, 0 });
+		}
+		else {
+			SlotID = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		m_Slots[SlotID].Index = uint32_t(m_Parents.size());
+
+		// append as root, parent() moves it into place
+		m_Parents.push_back(InvalidIndex);
+		m_SubtreeSizes.push_back(1);
+		m_NodeSlots.push_back(SlotID);
+		m_Translations.push_back(Translation);
+		m_Rotations.push_back(Rotation);
+		m_Scales.push_back(Scale);
+		m_WorldTranslations.push_back(Translation);
+		m_WorldRotations.push_back(Rotation);
+		m_WorldScales.push_back(Scale);
+		m_Dirty.push_back(1);
+
+		Handle Rval;
+		Rval.Slot = SlotID;
+		Rval.Generation = m_Slots[SlotID].Generation;
+		if (Parent != Handle()) parent(Rval, Parent);
+		return Rval;
+	}//create
+
+	void TransformHierarchy::destroy(Handle Node) {
+		const uint32_t Begin = index(Node);
+		const uint32_t Count = m_SubtreeSizes[Begin];
+		for (uint32_t i = m_Parents[Begin]; i != InvalidIndex; i = m_Parents[i]) m_SubtreeSizes[i] -= Count;
+
+		// move subtree to the end and cut it off
+		const uint32_t End = uint32_t(m_Parents.size());
+		moveRange(Begin, Count, End);
+		for (uint32_t i = End - Count; i < End; ++i) {
+			Slot* pSlot = &m_Slots[m_NodeSlots[i]];
+			pSlot->Index = InvalidIndex;
+			pSlot->Generation++;
+			m_FreeSlots.push_back(m_NodeSlots[i]);
+		}//for[destroyed nodes]
+
+		const uint32_t NodeCount = End - Count;
+		m_Parents.resize(NodeCount);
+		m_SubtreeSizes.resize(NodeCount);
+		m_NodeSlots.resize(NodeCount);
+		m_Translations.resize(NodeCount);
+		m_Rotations.resize(NodeCount);
+		m_Scales.resize(NodeCount);
+		m_WorldTranslations.resize(NodeCount);
+		m_WorldRotations.resize(NodeCount);
+		m_WorldScales.resize(NodeCount);
+		m_Dirty.resize(NodeCount);
+	}//destroy
+
+	bool TransformHierarchy::valid(Handle Node)const {
+		if (Node.Slot >= m_Slots.size()) return false;
+		return (m_Slots[Node.Slot].Generation == Node.Generation && m_Slots[Node.Slot].Index != InvalidIndex);
+	}//valid
+
+	uint32_t TransformHierarchy::nodeCount(void)const {
+		return uint32_t(m_Parents.size());
+	}//nodeCount
+
+	void TransformHierarchy::parent(Handle Node, Handle Parent) {
+		const uint32_t Begin = index(Node);
+		const uint32_t Count = m_SubtreeSizes[Begin];
+		const uint32_t ParentIndex = (Parent == Handle()) ? InvalidIndex : index(Parent);
+		if (ParentIndex == m_Parents[Begin]) return; // nothing to do
+		if (ParentIndex != InvalidIndex && ParentIndex >= Begin && ParentIndex < Begin + Count) throw CForgeExcept("Node can not become child of its own subtree!");
+
+		// new place is the end of the parent's subtree, roots go to the very end
+		const uint32_t Dest = (ParentIndex == InvalidIndex) ? nodeCount() : ParentIndex + m_SubtreeSizes[ParentIndex];
+		for (uint32_t i = m_Parents[Begin]; i != InvalidIndex; i = m_Parents[i]) m_SubtreeSizes[i] -= Count;
+		moveRange(Begin, Count, Dest);
+
+		const uint32_t NodeIndex = m_Slots[Node.Slot].Index;
+		m_Parents[NodeIndex] = (ParentIndex == InvalidIndex) ? InvalidIndex : m_Slots[Parent.Slot].Index;
+		for (uint32_t i = m_Parents[NodeIndex]; i != InvalidIndex; i = m_Parents[i]) m_SubtreeSizes[i] += Count;
+		m_Dirty[NodeIndex] = 1;
+	}//parent
+
+	TransformHierarchy::Handle TransformHierarchy::parent(Handle Node)const {
+		const uint32_t Parent = m_Parents[index(Node)];
+		return (Parent == InvalidIndex) ? Handle() : handle(Parent);
+	}//parent
+
+	uint32_t TransformHierarchy::childCount(Handle Node)const {
+		const uint32_t Begin = index(Node);
+		const uint32_t End = Begin + m_SubtreeSizes[Begin];
+		uint32_t Rval = 0;
+		// children follow their parent, each one followed by its own subtree
+		for (uint32_t i = Begin + 1; i < End; i += m_SubtreeSizes[i]) Rval++;
+		return Rval;
+	}//childCount
+
+	TransformHierarchy::Handle TransformHierarchy::child(Handle Node, uint32_t Index)const {
+		const uint32_t Begin = index(Node);
+		const uint32_t End = Begin + m_SubtreeSizes[Begin];
+		uint32_t Child = Begin + 1;
+		for (uint32_t i = 0; i < Index && Child < End; ++i) Child += m_SubtreeSizes[Child];
+		if (Child >= End) throw IndexOutOfBoundsExcept("Index");
+		return handle(Child);
+	}//child
+
+	uint32_t TransformHierarchy::subtreeSize(Handle Node)const {
+		return m_SubtreeSizes[index(Node)];
+	}//subtreeSize
+
+	void TransformHierarchy::translation(Handle Node, Eigen::Vector3f Translation) {
+		const uint32_t Index = index(Node);
+		m_Translations[Index] = Translation;
+		m_Dirty[Index] = 1;
+	}//translation
+
+	void TransformHierarchy::rotation(Handle Node, Eigen::Quaternionf Rotation) {
+		const uint32_t Index = index(Node);
+		m_Rotations[Index] = Rotation;
+		m_Dirty[Index] = 1;
+	}//rotation
+
+	void TransformHierarchy::scale(Handle Node, Eigen::Vector3f Scale) {
+		const uint32_t Index = index(Node);
+		m_Scales[Index] = Scale;
+		m_Dirty[Index] = 1;
+	}//scale
+
+	Eigen::Vector3f TransformHierarchy::translation(Handle Node)const {
+		return m_Translations[index(Node)];
+	}//translation
+
+	Eigen::Quaternionf TransformHierarchy::rotation(Handle Node)const {
+		return m_Rotations[index(Node)];
+	}//rotation
+
+	Eigen::Vector3f TransformHierarchy::scale(Handle Node)const {
+		return m_Scales[index(Node)];
+	}//scale
+
+	void TransformHierarchy::update(void) {
+		const uint32_t NodeCount = nodeCount();
+		// parents precede their children, so a single sweep sees every parent up to date
+		for (uint32_t i = 0; i < NodeCount; ++i) {
+			const uint32_t Parent = m_Parents[i];
+			if (Parent != InvalidIndex && m_Dirty[Parent]) m_Dirty[i] = 1;
+			if (!m_Dirty[i]) continue;
+
+			if (Parent == InvalidIndex) {
+				m_WorldTranslations[i] = m_Translations[i];
+				m_WorldRotations[i] = m_Rotations[i];
+				m_WorldScales[i] = m_Scales[i];
+			}
+			else {
+				m_WorldTranslations[i] = m_WorldTranslations[Parent] + m_WorldRotations[Parent] * m_Translations[i];
+				m_WorldRotations[i] = m_WorldRotations[Parent] * m_Rotations[i];
+				m_WorldScales[i] = m_WorldScales[Parent].cwiseProduct(m_Scales[i]);
+			}
+		}//for[nodes]
+		std::fill(m_Dirty.begin(), m_Dirty.end(), uint8_t(0));
+	}//update
+
+	void TransformHierarchy::worldTransformation(Handle Node, Eigen::Vector3f* pTranslation, Eigen::Quaternionf* pRotation, Eigen::Vector3f* pScale)const {
+		const uint32_t Index = index(Node);
+		if (nullptr != pTranslation) (*pTranslation) = m_WorldTranslations[Index];
+		if (nullptr != pRotation) (*pRotation) = m_WorldRotations[Index];
+		if (nullptr != pScale) (*pScale) = m_WorldScales[Index];
+	}//worldTransformation
+
+	uint32_t TransformHierarchy::index(Handle Node)const {
+		if (!valid(Node)) throw CForgeExcept("Invalid node handle!");
+		return m_Slots[Node.Slot].Index;
+	}//index
+
+	TransformHierarchy::Handle TransformHierarchy::handle(uint32_t Index)const {
+		Handle Rval;
+		Rval.Slot = m_NodeSlots[Index];
+		Rval.Generation = m_Slots[Rval.Slot].Generation;
+		return Rval;
+	}//handle
+
+	void TransformHierarchy::moveRange(uint32_t Begin, uint32_t Count, uint32_t Dest) {
+		const uint32_t End = Begin + Count;
+		if (Dest == Begin || Dest == End) return; // already in place
+
+		// new position of every node index affected by the move
+		auto Remap = [&](uint32_t Index) -> uint32_t {
+			if (Index == InvalidIndex) return Index;
+			if (Index >= Begin && Index < End) return (Dest > Begin) ? Index - Begin + Dest - Count : Index - Begin + Dest;
+			if (Dest > Begin && Index >= End && Index < Dest) return Index - Count;
+			if (Dest < Begin && Index >= Dest && Index < Begin) return Index + Count;
+			return Index;
+		};
+
+		rotateRange(m_Parents, Begin, Count, Dest);
+		rotateRange(m_SubtreeSizes, Begin, Count, Dest);
+		rotateRange(m_NodeSlots, Begin, Count, Dest);
+		rotateRange(m_Translations, Begin, Count, Dest);
+		rotateRange(m_Rotations, Begin, Count, Dest);
+		rotateRange(m_Scales, Begin, Count, Dest);
+		rotateRange(m_WorldTranslations, Begin, Count, Dest);
+		rotateRange(m_WorldRotations, Begin, Count, Dest);
+		rotateRange(m_WorldScales, Begin, Count, Dest);
+		rotateRange(m_Dirty, Begin, Count, Dest);
+
+		for (auto& i : m_Parents) i = Remap(i);
+		for (uint32_t i = 0; i < m_NodeSlots.size(); ++i) m_Slots[m_NodeSlots[i]].Index = i;
+	}//moveRange
+
+}//name space
@@ -0,0 +1,139 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): TransformHierarchy.h and TransformHierarchy.cpp                  *
+*                                                                           *
+* Content: Flat, cache friendly storage of a transformation hierarchy.     *
+*                                                                           *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_TRANSFORMHIERARCHY_H__
+#define __CFORGE_TRANSFORMHIERARCHY_H__
+
+#include <vector>
+#include "../../Core/CForgeObject.h"
+
+namespace CForge {
+	/**
+	* \brief Transformation hierarchy stored in contiguous arrays, an alternative backend to a tree of SGNTransformation nodes for very large scenes.
+	*
+	* Nodes are kept in depth first order together with the index of their parent and the size of their subtree. Parents therefore always precede their children and updating all world transformations is a single linear sweep. A subtree is a contiguous range, structural changes move ranges and cost linear time, so they should be rare compared to transformation changes.
+	*
+	* Nodes are addressed by handles. A handle stays valid while its node moves within the arrays and becomes invalid once the node is destroyed, even if the slot gets reused.
+	*
+	* Transformations compose like SGNTransformation: translation is rotated by the parent, scale is applied component wise.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API TransformHierarchy : public CForgeObject {
+	public:
+		struct Handle {
+			uint32_t Slot;
+			uint32_t Generation;
+
+			Handle(void) {
+				Slot = UINT32_MAX;
+				Generation = 0;
+			}
+			bool operator==(const Handle& Other)const {
+				return (Slot == Other.Slot && Generation == Other.Generation);
+			}
+			bool operator!=(const Handle& Other)const {
+				return !(*this == Other);
+			}
+		};
+
+		TransformHierarchy(void);
+		~TransformHierarchy(void);
+
+		void init(void);
+		void clear(void);
+
+		/**
+		* \brief Creates a node.
+		* \param[in] Parent Parent node. Default handle creates a root.
+		* \return Handle of the new node.
+		*/
+		Handle create(Handle Parent = Handle(), Eigen::Vector3f Translation = Eigen::Vector3f::Zero(), Eigen::Quaternionf Rotation = Eigen::Quaternionf::Identity(), Eigen::Vector3f Scale = Eigen::Vector3f::Ones());
+
+		/**
+		* \brief Destroys a node together with its subtree.
+		*/
+		void destroy(Handle Node);
+
+		bool valid(Handle Node)const;
+		uint32_t nodeCount(void)const;
+
+		/**
+		* \brief Moves a node with its subtree below another parent.
+		* \param[in] Parent New parent. Default handle makes the node a root. Must not be part of the node's subtree.
+		*/
+		void parent(Handle Node, Handle Parent);
+		Handle parent(Handle Node)const;
+		uint32_t childCount(Handle Node)const;
+		Handle child(Handle Node, uint32_t Index)const;
+		uint32_t subtreeSize(Handle Node)const; ///< Number of nodes of the subtree including the node itself.
+
+		void translation(Handle Node, Eigen::Vector3f Translation);
+		void rotation(Handle Node, Eigen::Quaternionf Rotation);
+		void scale(Handle Node, Eigen::Vector3f Scale);
+
+		Eigen::Vector3f translation(Handle Node)const;
+		Eigen::Quaternionf rotation(Handle Node)const;
+		Eigen::Vector3f scale(Handle Node)const;
+
+		/**
+		* \brief Recomputes the world transformations of all nodes whose local transformation or one of whose ancestors changed.
+		*/
+		void update(void);
+
+		/**
+		* \brief World transformation as computed by the last update.
+		*/
+		void worldTransformation(Handle Node, Eigen::Vector3f* pTranslation, Eigen::Quaternionf* pRotation, Eigen::Vector3f* pScale)const;
+
+	protected:
+		static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+		struct Slot {
+			uint32_t Index; ///< Position in the node arrays, InvalidIndex for free slots
+			uint32_t Generation;
+		};
+
+		uint32_t index(Handle Node)const; ///< Throws if the handle is invalid.
+		Handle handle(uint32_t Index)const;
+
+		/**
+		* \brief Moves a contiguous range of nodes in all arrays and fixes parent indices and slots.
+		* \param[in] Begin First node of the range.
+		* \param[in] Count Number of nodes.
+		* \param[in] Dest Position before the move the range gets inserted at. Must not lie within the range.
+		*/
+		void moveRange(uint32_t Begin, uint32_t Count, uint32_t Dest);
+
+		std::vector<uint32_t> m_Parents; ///< Index of the parent, InvalidIndex for roots
+		std::vector<uint32_t> m_SubtreeSizes;
+		std::vector<uint32_t> m_NodeSlots; ///< Slot of each node
+		std::vector<Eigen::Vector3f> m_Translations;
+		std::vector<Eigen::Quaternionf> m_Rotations;
+		std::vector<Eigen::Vector3f> m_Scales;
+		std::vector<Eigen::Vector3f> m_WorldTranslations;
+		std::vector<Eigen::Quaternionf> m_WorldRotations;
+		std::vector<Eigen::Vector3f> m_WorldScales;
+		std::vector<uint8_t> m_Dirty;
+
+		std::vector<Slot> m_Slots;
+		std::vector<uint32_t> m_FreeSlots;
+	};//TransformHierarchy
+
+}//name space
+
+#endif
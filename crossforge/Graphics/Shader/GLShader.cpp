@@ -16,6 +16,9 @@ namespace CForge {
 		case ATTRIB_BONE_WEIGHTS:	Rval = 5; break;
 		case ATTRIB_COLOR:			Rval = 6; break;
 		case ATTRIB_SPARE:			Rval = 7; break;
+		case ATTRIB_INSTANCE_MODELMATRIX:	Rval = 8; break;
+		case ATTRIB_INSTANCE_NORMALMATRIX:	Rval = 12; break;
+		case ATTRIB_INSTANCE_TIMEOFFSET:	Rval = 15; break;
 		default: {
 			throw CForgeExcept("Invalid vertex attribute specified!");
 		}break;
@@ -206,6 +209,8 @@ namespace CForge {
 			m_DefaultUBOBindingPoints[DEFAULTUBO_TEXTDATA] = glGetUniformBlockIndex(m_ShaderProgram, UBOTextDataName.c_str());
 			m_DefaultUBOBindingPoints[DEFAULTUBO_COLORADJUSTMENT] = glGetUniformBlockIndex(m_ShaderProgram, UBOColorAdjustmentDataName.c_str());
 			m_DefaultUBOBindingPoints[DEFAULTUBO_INSTANCE] = glGetUniformBlockIndex(m_ShaderProgram, UBOInstancedDataName.c_str());
+			m_DefaultUBOBindingPoints[DEFAULTUBO_VERTEXANIMATIONDATA] = glGetUniformBlockIndex(m_ShaderProgram, UBOVertexAnimationDataName.c_str());
+			m_DefaultUBOBindingPoints[DEFAULTUBO_SKINNINGPALETTEDATA] = glGetUniformBlockIndex(m_ShaderProgram, UBOSkinningPaletteDataName.c_str());
 
 			// retrieve default texture bindign points
 			m_DefaultTextureLocations[DEFAULTTEX_ALBEDO] = uniformLocation(TextureAlbedoName);
@@ -216,6 +221,10 @@ namespace CForge {
 			m_DefaultTextureLocations[DEFAULTTEX_SHADOW2] = uniformLocation(TextureShadow2Name);
 			m_DefaultTextureLocations[DEFAULTTEX_SHADOW3] = uniformLocation(TextureShadow3Name);
 			m_DefaultTextureLocations[DEFAULTTEX_MORPHTARGETDATA] = uniformLocation(TextureMorphTargetDataName);
+			m_DefaultTextureLocations[DEFAULTTEX_MORPHTARGETINDEX] = uniformLocation(TextureMorphTargetIndexName);
+			m_DefaultTextureLocations[DEFAULTTEX_MORPHTARGETWEIGHTS] = uniformLocation(TextureMorphTargetWeightsName);
+			m_DefaultTextureLocations[DEFAULTTEX_VERTEXANIMATIONDATA] = uniformLocation(TextureVertexAnimationDataName);
+			m_DefaultTextureLocations[DEFAULTTEX_SKINNINGPALETTES] = uniformLocation(TextureSkinningPalettesName);
 
 			// bind shader and uniform blocks together
 			for (uint8_t i = 0; i < DEFAULTUBO_COUNT; ++i) {
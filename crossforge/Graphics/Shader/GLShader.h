@@ -40,6 +40,9 @@ namespace CForge {
 			ATTRIB_BONE_WEIGHTS,
 			ATTRIB_COLOR,
 			ATTRIB_SPARE,
+			ATTRIB_INSTANCE_MODELMATRIX,	///< per instance model matrix, occupies 4 consecutive locations
+			ATTRIB_INSTANCE_NORMALMATRIX,	///< per instance normal matrix, occupies 3 consecutive locations
+			ATTRIB_INSTANCE_TIMEOFFSET,		///< per instance playback time offset of baked vertex animations
 		};
 
 		enum ShaderType : int8_t {
@@ -61,6 +64,8 @@ namespace CForge {
 			DEFAULTUBO_TEXTDATA,
 			DEFAULTUBO_COLORADJUSTMENT,
 			DEFAULTUBO_INSTANCE,	
+			DEFAULTUBO_VERTEXANIMATIONDATA,
+			DEFAULTUBO_SKINNINGPALETTEDATA,
 			DEFAULTUBO_COUNT,
 		};
 
@@ -74,6 +79,10 @@ namespace CForge {
 			DEFAULTTEX_SHADOW2,
 			DEFAULTTEX_SHADOW3,
 			DEFAULTTEX_MORPHTARGETDATA,
+			DEFAULTTEX_MORPHTARGETINDEX,
+			DEFAULTTEX_MORPHTARGETWEIGHTS,
+			DEFAULTTEX_VERTEXANIMATIONDATA,
+			DEFAULTTEX_SKINNINGPALETTES,
 			DEFAULTTEX_COUNT,
 		};
 
@@ -88,6 +97,8 @@ namespace CForge {
 		const std::string UBOTextDataName = "TextData";
 		const std::string UBOColorAdjustmentDataName = "ColorAdjustmentData";
 		const std::string UBOInstancedDataName = "InstancedData";
+		const std::string UBOVertexAnimationDataName = "VertexAnimationData";
+		const std::string UBOSkinningPaletteDataName = "SkinningPaletteData";
 
 		const std::string TextureAlbedoName = "TexAlbedo";
 		const std::string TextureNormalName = "TexNormal";
@@ -97,6 +108,10 @@ namespace CForge {
 		const std::string TextureShadow2Name = "TexShadow[2]";
 		const std::string TextureShadow3Name = "TexShadow[3]";
 		const std::string TextureMorphTargetDataName = "MorphTargetDataBuffer";
+		const std::string TextureMorphTargetIndexName = "MorphTargetIndexBuffer";
+		const std::string TextureMorphTargetWeightsName = "MorphTargetWeightBuffer";
+		const std::string TextureVertexAnimationDataName = "VertexAnimationDataBuffer";
+		const std::string TextureSkinningPalettesName = "SkinningPaletteBuffer";
 
 		static uint32_t attribArrayIndex(Attribute Attrib);
 
@@ -26,7 +26,7 @@ namespace CForge {
 
 	}//release
 
-	ShaderCode* SShaderManager::createShaderCode(std::string Code, std::string VersionTag, uint8_t ConfigOptions, std::string PrecisionTag) {
+	ShaderCode* SShaderManager::createShaderCode(std::string Code, std::string VersionTag, uint16_t ConfigOptions, std::string PrecisionTag) {
 		ShaderCode* pRval = nullptr;
 
 		// do not create repeatedly if same object definition
@@ -191,6 +191,9 @@ namespace CForge {
 			if (i->requiresConfig(ShaderCode::CONF_SKELETALANIMATION)) i->config(ShaderCode::CONF_SKELETALANIMATION);
 			if (i->requiresConfig(ShaderCode::CONF_VERTEXCOLORS)) i->config(ShaderCode::CONF_VERTEXCOLORS);
 			if (i->requiresConfig(ShaderCode::CONF_NORMALMAPPING)) i->config(ShaderCode::CONF_NORMALMAPPING);
+			if (i->requiresConfig(ShaderCode::CONF_INSTANCING)) i->config(ShaderCode::CONF_INSTANCING);
+			if (i->requiresConfig(ShaderCode::CONF_VERTEXANIMATION)) i->config(ShaderCode::CONF_VERTEXANIMATION);
+			if (i->requiresConfig(ShaderCode::CONF_SKINNINGPALETTES)) i->config(ShaderCode::CONF_SKINNINGPALETTES);
 			pShader->pShader->addVertexShader(i->code());
 		}//for[VS sources]
 
@@ -47,7 +47,7 @@ namespace CForge {
 		void release(void);
 
 		// Code can be path or actual GLSL code
-		ShaderCode* createShaderCode(std::string Code, std::string VersionTag, uint8_t ConfigOptions, std::string precisionTag);
+		ShaderCode* createShaderCode(std::string Code, std::string VersionTag, uint16_t ConfigOptions, std::string precisionTag);
 //		GLShader* buildShader(const std::vector<std::string>* pVSSources, const std::vector<std::string>* pFSSources, std::string *pErrorLog = nullptr);
 		GLShader* buildShader(std::vector<ShaderCode*>* pVSSources, std::vector<ShaderCode*> *pFSSources, std::string* pErrorLog);
         GLShader* buildComputeShader(std::vector<ShaderCode*>* pCSSources, std::string* pErrorLog);
@@ -15,7 +15,7 @@ namespace CForge {
 
 	}//Destructor
 
-	void ShaderCode::init(std::string ShaderCode, std::string VersionTag, uint8_t ConfigOptions, std::string PrecisionTag) {
+	void ShaderCode::init(std::string ShaderCode, std::string VersionTag, uint16_t ConfigOptions, std::string PrecisionTag) {
 		if (ShaderCode.empty()) throw CForgeExcept("Empty shader code specified!");
 
 		if (ShaderCode[0] == '#') {
@@ -144,13 +144,16 @@ namespace CForge {
 		addDefine("MORPHTARGET_ANIMATION");
 	}//config
 
-	void ShaderCode::config(uint8_t ConfigOptions) {
+	void ShaderCode::config(uint16_t ConfigOptions) {
 		if (ConfigOptions & CONF_LIGHTING) config(&m_LightConfig);
 		if (ConfigOptions & CONF_POSTPROCESSING) config(&m_PostProcessingConfig);
 		if (ConfigOptions & CONF_SKELETALANIMATION) config(&m_SkeletalAnimationConfig);
 		if (ConfigOptions & CONF_MORPHTARGETANIMATION) config(&m_MorphTargetAnimationConfig);
 		if (ConfigOptions & CONF_VERTEXCOLORS) addDefine("VERTEX_COLORS");
 		if (ConfigOptions & CONF_NORMALMAPPING) addDefine("NORMAL_MAPPING");
+		if (ConfigOptions & CONF_INSTANCING) addDefine("INSTANCED_RENDERING");
+		if (ConfigOptions & CONF_VERTEXANIMATION) addDefine("VERTEX_ANIMATION");
+		if (ConfigOptions & CONF_SKINNINGPALETTES) addDefine("SKINNING_PALETTES");
 	}//config
 
 	std::string ShaderCode::code(void)const {
@@ -190,7 +193,7 @@ namespace CForge {
 		}
 	}//changeConst
 
-	bool ShaderCode::requiresConfig(uint8_t ConfigOptions) {
+	bool ShaderCode::requiresConfig(uint16_t ConfigOptions) {
 		return (m_ConfigOptions & ConfigOptions);
 	}//requiresConfig
 
@@ -202,7 +205,7 @@ namespace CForge {
 		return m_VersionTag;
 	}//versionTag
 
-	uint8_t ShaderCode::configOptions(void)const {
+	uint16_t ShaderCode::configOptions(void)const {
 		return m_ConfigOptions;
 	}//configOptions
 
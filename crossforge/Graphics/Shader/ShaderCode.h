@@ -74,34 +74,37 @@ namespace CForge {
 			uint32_t Stub; // no configuration yet
 		};
 
-		enum ConfigOptions: uint8_t {
+		enum ConfigOptions: uint16_t {
 			CONF_LIGHTING				= 0x01,
 			CONF_POSTPROCESSING			= 0x02,
 			CONF_SKELETALANIMATION		= 0x04,
 			CONF_MORPHTARGETANIMATION	= 0x08,
 			CONF_VERTEXCOLORS			= 0x10,
 			CONF_NORMALMAPPING			= 0x20,
+			CONF_INSTANCING				= 0x40,
+			CONF_VERTEXANIMATION		= 0x80, ///< playback of baked vertex animation textures
+			CONF_SKINNINGPALETTES		= 0x100, ///< skinning matrices from a palette texture, one palette per instance
 		};
 
 		ShaderCode(void);
 		~ShaderCode(void);
 
-		void init(std::string ShaderCode, std::string VersionTag, uint8_t ConfigOptions, std::string PrecisionTag);
+		void init(std::string ShaderCode, std::string VersionTag, uint16_t ConfigOptions, std::string PrecisionTag);
 		void clear(void);
 
 		void config(LightConfig* pConfig);
 		void config(PostProcessingConfig* pConfig);
 		void config(SkeletalAnimationConfig* pConfig);
 		void config(MorphTargetAnimationConfig* pConfig);
-		void config(uint8_t ConfigOptions);
+		void config(uint16_t ConfigOptions);
 
 		std::string code(void)const;
 
-		bool requiresConfig(uint8_t ConfigOptions);
+		bool requiresConfig(uint16_t ConfigOptions);
 
 		std::string originalCode(void)const;
 		std::string versionTag(void)const;
-		uint8_t configOptions(void)const;
+		uint16_t configOptions(void)const;
 		std::string precisionTag(void)const;
 
 	protected:
@@ -111,7 +114,7 @@ namespace CForge {
 		std::string m_VersionTag;
 		std::string m_PrecisionTag;
 
-		uint8_t m_ConfigOptions;
+		uint16_t m_ConfigOptions;
 
 		LightConfig m_LightConfig;
 		PostProcessingConfig m_PostProcessingConfig;
@@ -1,8 +1,12 @@
+#include <algorithm>
 #include "UBOBoneData.h"
 
 namespace CForge {
 
 	UBOBoneData::UBOBoneData(void): CForgeObject("UBOBoneData") {
+		m_BoneCount = 0;
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
 
 	}//Constructor
 
@@ -13,12 +17,16 @@ namespace CForge {
 	void UBOBoneData::init(uint32_t BoneCount) {
 		clear();
 		m_BoneCount = BoneCount;
-		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_DYNAMIC_DRAW, nullptr, size());
+		m_Palette.assign(BoneCount, Eigen::Matrix4f::Identity());
+		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_DYNAMIC_DRAW, m_Palette.data(), size());
 	}//initialize
 
 	void UBOBoneData::clear(void) {
 		m_Buffer.clear();
 		m_BoneCount = 0;
+		m_Palette.clear();
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
 	}//clear
 
 	void UBOBoneData::bind(uint32_t BindingPoint) {
@@ -31,8 +39,42 @@ namespace CForge {
 
 	void UBOBoneData::skinningMatrix(uint32_t Index, Eigen::Matrix4f SkinningMat) {
 		if (Index >= m_BoneCount) throw IndexOutOfBoundsExcept("Index");
-		uint32_t Offset = Index * 16 * sizeof(float);
-		m_Buffer.bufferSubData(Offset, sizeof(float) * 16, SkinningMat.data());
+		if (m_Palette[Index] == SkinningMat) return;
+		m_Palette[Index] = SkinningMat;
+		markDirty(Index);
+		upload();
 	}//skinningMatrix
 
+	void UBOBoneData::skinningMatrices(const Eigen::Matrix4f* pSkinningMats, uint32_t Count, uint32_t FirstIndex) {
+		if (nullptr == pSkinningMats) throw NullpointerExcept("pSkinningMats");
+		if (FirstIndex + Count > m_BoneCount) throw IndexOutOfBoundsExcept("FirstIndex + Count");
+
+		for (uint32_t i = 0; i < Count; ++i) {
+			if (m_Palette[FirstIndex + i] == pSkinningMats[i]) continue;
+			m_Palette[FirstIndex + i] = pSkinningMats[i];
+			markDirty(FirstIndex + i);
+		}//for[matrices]
+		upload();
+	}//skinningMatrices
+
+	void UBOBoneData::upload(void) {
+		if (m_DirtyBegin >= m_DirtyEnd) return;
+		const uint32_t Offset = m_DirtyBegin * 16 * sizeof(float);
+		const uint32_t Size = (m_DirtyEnd - m_DirtyBegin) * 16 * sizeof(float);
+		m_Buffer.bufferSubData(Offset, Size, m_Palette[m_DirtyBegin].data());
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
+	}//upload
+
+	void UBOBoneData::markDirty(uint32_t Index) {
+		if (m_DirtyBegin >= m_DirtyEnd) {
+			m_DirtyBegin = Index;
+			m_DirtyEnd = Index + 1;
+		}
+		else {
+			m_DirtyBegin = std::min(m_DirtyBegin, Index);
+			m_DirtyEnd = std::max(m_DirtyEnd, Index + 1);
+		}
+	}//markDirty
+
 }//name-space
\ No newline at end of file
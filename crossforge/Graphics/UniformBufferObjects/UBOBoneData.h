@@ -24,6 +24,8 @@ namespace CForge {
 	/**
 	* \brief Uniform buffer object skeletal animation (Bones) related data.
 	*
+	* A CPU copy of the palette is kept. Writes only mark the bones that actually changed as dirty and the dirty range gets uploaded with a single glBufferSubData.
+	*
 	* \todo Do full documentation.
 	*/
 	class CFORGE_API UBOBoneData : public CForgeObject {
@@ -38,13 +40,23 @@ namespace CForge {
 
 		void skinningMatrix(uint32_t Index, Eigen::Matrix4f SkinningMat);
 
+		/**
+		* \brief Writes Count skinning matrices starting at bone FirstIndex and uploads the changed range at once.
+		*/
+		void skinningMatrices(const Eigen::Matrix4f* pSkinningMats, uint32_t Count, uint32_t FirstIndex = 0);
+		void upload(void); ///< Uploads the dirty range, if any.
+
 		uint32_t size(void)const;
 
 	protected:
+		void markDirty(uint32_t Index);
 
 	private:
 		GLBuffer m_Buffer;
 		uint32_t m_BoneCount;
+		std::vector<Eigen::Matrix4f> m_Palette; ///< CPU copy of the buffer's content
+		uint32_t m_DirtyBegin; ///< First dirty bone
+		uint32_t m_DirtyEnd; ///< One past the last dirty bone
 	};//UBOBoneData
 
 }//name space
@@ -1,3 +1,5 @@
+#include "../OpenGLHeader.h"
+#include "../../Math/CForgeMath.h"
 #include "UBOModelData.h"
 
 
@@ -5,16 +7,33 @@ namespace CForge {
 
 	UBOModelData::UBOModelData(void): CForgeObject("UBOModelData") {
 		m_ModelMatrixOffset = 0;
+		m_NormalMatrixOffset = 0;
+		m_SlotSize = 0;
+		m_SlotCount = 0;
+		m_NextSlot = 0;
+		m_ActiveSlot = 0;
+		m_WrapCount = 0;
 	}//Constructor
 
 	UBOModelData::~UBOModelData(void) {
 		clear();
 	}//Destructor
 
-	void UBOModelData::init(void) {
+	void UBOModelData::init(uint32_t SlotCount) {
 		clear();
-	
-		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_STATIC_DRAW, nullptr, size());
+		if (SlotCount == 0) throw CForgeExcept("Model data requires at least one slot!");
+
+		int32_t Alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &Alignment);
+		if (Alignment <= 0) Alignment = 256;
+
+		m_SlotSize = ((size() + Alignment - 1) / Alignment) * Alignment;
+		m_SlotCount = SlotCount;
+		m_NextSlot = 0;
+		m_ActiveSlot = 0;
+		m_Staging.assign(m_SlotSize * m_SlotCount, 0);
+
+		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_DYNAMIC_DRAW, m_Staging.data(), m_Staging.size());
 		m_ModelMatrixOffset = 0;
 		m_NormalMatrixOffset = 16 * sizeof(float);
 	}//initialize
@@ -22,11 +41,15 @@ namespace CForge {
 	void UBOModelData::clear(void) {
 		m_Buffer.clear();
 		m_ModelMatrixOffset = 0;
+		m_SlotCount = 0;
+		m_NextSlot = 0;
+		m_ActiveSlot = 0;
+		m_Staging.clear();
 	}//clear
 
 
 	void UBOModelData::bind(uint32_t BindingPoint) {
-		m_Buffer.bindBufferBase(BindingPoint);
+		m_Buffer.bindBufferRange(BindingPoint, m_ActiveSlot * m_SlotSize, size());
 	}//bind
 
 	uint32_t UBOModelData::size(void)const {
@@ -39,12 +62,74 @@ namespace CForge {
 	}//size
 
 	void UBOModelData::modelMatrix(Eigen::Matrix4f Mat) {
-		m_Buffer.bufferSubData(m_ModelMatrixOffset, 16 * sizeof(float), Mat.data());
+		m_Buffer.bufferSubData(m_ActiveSlot * m_SlotSize + m_ModelMatrixOffset, 16 * sizeof(float), Mat.data());
 
 	}//modelMatrix
 
 	void UBOModelData::normalMatrix(Eigen::Matrix4f Mat) {
-		m_Buffer.bufferSubData(m_NormalMatrixOffset, 12 * sizeof(float), Mat.block<3,4>(0,0).data());
+		m_Buffer.bufferSubData(m_ActiveSlot * m_SlotSize + m_NormalMatrixOffset, 12 * sizeof(float), Mat.block<3,4>(0,0).data());
 	}//normalMatrix
 
+	void UBOModelData::update(const Eigen::Matrix4f& ModelMatrix, const Eigen::Matrix3f& NormalMatrix) {
+		const uint32_t Slot = reserve(1);
+		slotData(Slot, ModelMatrix, NormalMatrix);
+		upload(Slot, 1);
+		activeSlot(Slot);
+	}//update
+
+	uint32_t UBOModelData::reserve(uint32_t Count) {
+		if (Count == 0) throw CForgeExcept("Reserving zero slots is not possible!");
+
+		// orphaning re-specifies the storage from the staging copy, so the driver does not have to
+		// wait for draws still in flight and previously reserved slots keep their content
+		if (Count > m_SlotCount) {
+			m_SlotCount = CForgeMath::nextPowerOfTwo(Count);
+			m_Staging.resize(m_SlotSize * m_SlotCount, 0);
+			m_Buffer.bufferData(m_Staging.data(), m_Staging.size());
+			m_NextSlot = 0;
+			m_WrapCount++;
+		}
+		else if (m_NextSlot + Count > m_SlotCount) {
+			m_Buffer.bufferData(m_Staging.data(), m_Staging.size());
+			m_NextSlot = 0;
+			m_WrapCount++;
+		}
+
+		const uint32_t Rval = m_NextSlot;
+		m_NextSlot += Count;
+		return Rval;
+	}//reserve
+
+	void UBOModelData::slotData(uint32_t Slot, const Eigen::Matrix4f& ModelMatrix, const Eigen::Matrix3f& NormalMatrix) {
+		if (Slot >= m_SlotCount) throw IndexOutOfBoundsExcept("Slot");
+		float* pData = (float*)&m_Staging[Slot * m_SlotSize];
+		memcpy(&pData[0], ModelMatrix.data(), 16 * sizeof(float));
+		// mat4x3 in std140 layout: each column padded to vec4, 4th column unused
+		for (uint32_t i = 0; i < 3; ++i) {
+			pData[16 + i * 4 + 0] = NormalMatrix(0, i);
+			pData[16 + i * 4 + 1] = NormalMatrix(1, i);
+			pData[16 + i * 4 + 2] = NormalMatrix(2, i);
+			pData[16 + i * 4 + 3] = 0.0f;
+		}
+	}//slotData
+
+	void UBOModelData::upload(uint32_t FirstSlot, uint32_t Count) {
+		if (Count == 0) return;
+		if (FirstSlot + Count > m_SlotCount) throw IndexOutOfBoundsExcept("FirstSlot + Count");
+		m_Buffer.bufferSubData(FirstSlot * m_SlotSize, (Count - 1) * m_SlotSize + size(), &m_Staging[FirstSlot * m_SlotSize]);
+	}//upload
+
+	void UBOModelData::activeSlot(uint32_t Slot) {
+		if (Slot >= m_SlotCount) throw IndexOutOfBoundsExcept("Slot");
+		m_ActiveSlot = Slot;
+	}//activeSlot
+
+	uint32_t UBOModelData::activeSlot(void)const {
+		return m_ActiveSlot;
+	}//activeSlot
+
+	uint32_t UBOModelData::wrapCount(void)const {
+		return m_WrapCount;
+	}//wrapCount
+
 }//name space
\ No newline at end of file
@@ -24,6 +24,8 @@ namespace CForge {
 	/**
 	* \brief Uniform buffer object for model related data.
 	* 
+	* The buffer is a ring of slots, one per draw call. Each update writes a fresh slot that gets bound with glBindBufferRange, so data of draws still in flight is never overwritten. Running out of slots orphans the buffer. Multiple slots can be filled and uploaded at once (reserve, slotData, upload).
+	* 
 	* \todo Do full documentation.
 	*/
 	class CFORGE_API UBOModelData: public CForgeObject {
@@ -31,7 +33,7 @@ namespace CForge {
 		UBOModelData(void);
 		~UBOModelData(void);
 
-		void init(void);
+		void init(uint32_t SlotCount = 1024);
 		void clear(void);
 		void bind(uint32_t BindingPoint);
 		uint32_t size(void)const;
@@ -39,10 +41,26 @@ namespace CForge {
 		void modelMatrix(Eigen::Matrix4f Mat);
 		void normalMatrix(Eigen::Matrix4f Mat);
 
+		void update(const Eigen::Matrix4f &ModelMatrix, const Eigen::Matrix3f &NormalMatrix);
+
+		uint32_t reserve(uint32_t Count);
+		void slotData(uint32_t Slot, const Eigen::Matrix4f& ModelMatrix, const Eigen::Matrix3f& NormalMatrix);
+		void upload(uint32_t FirstSlot, uint32_t Count);
+		void activeSlot(uint32_t Slot);
+		uint32_t activeSlot(void)const;
+		uint32_t wrapCount(void)const; ///< Number of times the ring wrapped around. Reserved slots are only valid as long as this does not change.
+
 	protected:
 		GLBuffer m_Buffer;
 		uint32_t m_ModelMatrixOffset;
 		uint32_t m_NormalMatrixOffset;
+
+		uint32_t m_SlotSize; ///< Size of one slot in bytes (respects uniform buffer offset alignment)
+		uint32_t m_SlotCount;
+		uint32_t m_NextSlot;
+		uint32_t m_ActiveSlot;
+		uint32_t m_WrapCount;
+		std::vector<uint8_t> m_Staging;
 	};//UBOModelData
 
 
@@ -13,17 +13,11 @@ namespace CForge {
 	void UBOMorphTargetData::init(void) {
 		clear();
 
-		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_DYNAMIC_DRAW, nullptr, size());
-		m_DataOffset = 0;
-		m_ActivationIDsOffset = 4 * sizeof(int32_t);
-		m_ActivationStrengthsOffset = m_ActivationIDsOffset + 3 * 4 * sizeof(int32_t);
+		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_STATIC_DRAW, nullptr, size());
 
 	}//initialize
 
 	void UBOMorphTargetData::clear(void) {
-		m_ActivationIDsOffset = 0;
-		m_ActivationStrengthsOffset = 0;
-		m_DataOffset = 0;
 		m_Buffer.clear();
 	}//clear
 
@@ -38,26 +32,12 @@ namespace CForge {
 	uint32_t UBOMorphTargetData::size(void)const {
 		uint32_t Rval = 0;
 		Rval += 4 * sizeof(int32_t); // Data
-		Rval += 3 * 4 * sizeof(int32_t); // activation IDs
-		Rval += 3 * 4 * sizeof(float); // activation strengths
 		return Rval;
 	}//size
 
-	void UBOMorphTargetData::setMorphTargetParam(uint32_t Index, uint32_t MorphTargetID, float Strength) {
-		if (Index > 11) throw IndexOutOfBoundsExcept("Morph Target index out of bounds!");
-		uint32_t Offset = m_ActivationIDsOffset + Index * sizeof(int32_t);
-		m_Buffer.bufferSubData(Offset, sizeof(int32_t), (const void*)&MorphTargetID);
-		Offset = m_ActivationStrengthsOffset + Index * sizeof(float);
-		m_Buffer.bufferSubData(Offset, sizeof(float), (const void*)&Strength);
-
-	}//setMorphTargetParam
-
-	void UBOMorphTargetData::activeMorphTargets(int32_t Count) {
-		m_Buffer.bufferSubData(m_DataOffset + sizeof(int32_t), sizeof(int32_t), (const void*)&Count);
-	}//activeMorphTargets
-
-	void UBOMorphTargetData::dataOffset(int32_t DataOffset) {
-		m_Buffer.bufferSubData(m_DataOffset, sizeof(int32_t), (const void*)&DataOffset);
-	}//dataOffset
+	void UBOMorphTargetData::layout(int32_t TextureWidth, int32_t MorphTargetCount) {
+		const int32_t Data[4] = { TextureWidth, MorphTargetCount, 0, 0 };
+		m_Buffer.bufferSubData(0, sizeof(Data), (const void*)Data);
+	}//layout
 
 }//name space
\ No newline at end of file
@@ -33,17 +33,16 @@ namespace CForge {
 		void bind(uint32_t BindingPoint);
 		uint32_t size(void)const;
 
-		void setMorphTargetParam(uint32_t Index, uint32_t MorphTargetID, float Strength);
-		void activeMorphTargets(int32_t Count);
-		void dataOffset(int32_t DataOffset);
+		/**
+		* \brief Sets the layout of the sparse morph target textures.
+		* \param[in] TextureWidth Width at which the entries of the morph target textures wrap into the next row.
+		* \param[in] MorphTargetCount Number of morph targets (entries of the weight texture).
+		*/
+		void layout(int32_t TextureWidth, int32_t MorphTargetCount);
 
 	protected:
 		GLBuffer m_Buffer;
 
-		uint32_t m_DataOffset;
-		uint32_t m_ActivationIDsOffset;
-		uint32_t m_ActivationStrengthsOffset;
-
 	};//UBOMorphTargetData
 }//name space
 
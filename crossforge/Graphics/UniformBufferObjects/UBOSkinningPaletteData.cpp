@@ -0,0 +1,39 @@
+#include "UBOSkinningPaletteData.h"
+
+namespace CForge {
+
+	UBOSkinningPaletteData::UBOSkinningPaletteData(void): CForgeObject("UBOSkinningPaletteData") {
+
+	}//Constructor
+
+	UBOSkinningPaletteData::~UBOSkinningPaletteData(void) {
+		clear();
+	}//Destructor
+
+	void UBOSkinningPaletteData::init(void) {
+		clear();
+		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_STATIC_DRAW, nullptr, size());
+	}//initialize
+
+	void UBOSkinningPaletteData::clear(void) {
+		m_Buffer.clear();
+	}//clear
+
+	void UBOSkinningPaletteData::release(void) {
+		delete this;
+	}//release
+
+	void UBOSkinningPaletteData::bind(uint32_t BindingPoint) {
+		m_Buffer.bindBufferBase(BindingPoint);
+	}//bind
+
+	uint32_t UBOSkinningPaletteData::size(void)const {
+		return 4 * sizeof(int32_t); // Data
+	}//size
+
+	void UBOSkinningPaletteData::layout(int32_t JointCount, int32_t TextureWidth) {
+		const int32_t Data[4] = { JointCount, TextureWidth, 0, 0 };
+		m_Buffer.bufferSubData(0, sizeof(Data), (const void*)Data);
+	}//layout
+
+}//name space
@@ -0,0 +1,49 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): UBOSkinningPaletteData.h and UBOSkinningPaletteData.cpp          *
+*                                                                           *
+* Content: Uniform buffer describing the layout of a skinning palette      *
+*          texture.                                                         *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_UBOSKINNINGPALETTEDATA_H__
+#define __CFORGE_UBOSKINNINGPALETTEDATA_H__
+
+#include "../GLBuffer.h"
+
+namespace CForge {
+	/**
+	* \brief Layout of a skinning palette texture (SkinningPaletteData block of the default shaders).
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API UBOSkinningPaletteData: public CForgeObject {
+	public:
+		UBOSkinningPaletteData(void);
+		~UBOSkinningPaletteData(void);
+
+		void init(void);
+		void clear(void);
+		void release(void);
+
+		void bind(uint32_t BindingPoint);
+		uint32_t size(void)const;
+
+		void layout(int32_t JointCount, int32_t TextureWidth);
+
+	protected:
+		GLBuffer m_Buffer;
+	};//UBOSkinningPaletteData
+
+}//name space
+
+#endif
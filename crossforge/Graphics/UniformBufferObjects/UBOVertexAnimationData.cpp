@@ -0,0 +1,57 @@
+#include "UBOVertexAnimationData.h"
+
+namespace CForge {
+
+	UBOVertexAnimationData::UBOVertexAnimationData(void): CForgeObject("UBOVertexAnimationData") {
+		m_DataOffset = 0;
+		m_TimingOffset = 0;
+	}//Constructor
+
+	UBOVertexAnimationData::~UBOVertexAnimationData(void) {
+		clear();
+	}//Destructor
+
+	void UBOVertexAnimationData::init(void) {
+		clear();
+
+		m_Buffer.init(GLBuffer::BTYPE_UNIFORM, GLBuffer::BUSAGE_DYNAMIC_DRAW, nullptr, size());
+		m_DataOffset = 0;
+		m_TimingOffset = 4 * sizeof(int32_t);
+	}//initialize
+
+	void UBOVertexAnimationData::clear(void) {
+		m_DataOffset = 0;
+		m_TimingOffset = 0;
+		m_Buffer.clear();
+	}//clear
+
+	void UBOVertexAnimationData::release(void) {
+		delete this;
+	}//release
+
+	void UBOVertexAnimationData::bind(uint32_t BindingPoint) {
+		m_Buffer.bindBufferBase(BindingPoint);
+	}//bind
+
+	uint32_t UBOVertexAnimationData::size(void)const {
+		uint32_t Rval = 0;
+		Rval += 4 * sizeof(int32_t); // Data
+		Rval += 4 * sizeof(float); // Timing
+		return Rval;
+	}//size
+
+	void UBOVertexAnimationData::layout(int32_t Mode, int32_t FrameCount, int32_t ElementCount, int32_t TextureWidth) {
+		const int32_t Data[4] = { Mode, FrameCount, ElementCount, TextureWidth };
+		m_Buffer.bufferSubData(m_DataOffset, sizeof(Data), (const void*)Data);
+	}//layout
+
+	void UBOVertexAnimationData::timing(float TimeStep, float Duration) {
+		const float Data[2] = { TimeStep, Duration };
+		m_Buffer.bufferSubData(m_TimingOffset + sizeof(float), sizeof(Data), (const void*)Data);
+	}//timing
+
+	void UBOVertexAnimationData::time(float t) {
+		m_Buffer.bufferSubData(m_TimingOffset, sizeof(float), (const void*)&t);
+	}//time
+
+}//name space
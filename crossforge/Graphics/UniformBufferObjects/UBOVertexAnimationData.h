@@ -0,0 +1,54 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): UBOVertexAnimationData.h and UBOVertexAnimationData.cpp          *
+*                                                                           *
+* Content: Uniform buffer with the playback parameters of a baked vertex    *
+*          animation.                                                       *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_UBOVERTEXANIMATIONDATA_H__
+#define __CFORGE_UBOVERTEXANIMATIONDATA_H__
+
+#include "../GLBuffer.h"
+
+namespace CForge {
+	/**
+	* \brief Playback parameters of a baked vertex animation (VertexAnimationData block of the default shaders).
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API UBOVertexAnimationData: public CForgeObject {
+	public:
+		UBOVertexAnimationData(void);
+		~UBOVertexAnimationData(void);
+
+		void init(void);
+		void clear(void);
+		void release(void);
+
+		void bind(uint32_t BindingPoint);
+		uint32_t size(void)const;
+
+		void layout(int32_t Mode, int32_t FrameCount, int32_t ElementCount, int32_t TextureWidth);
+		void timing(float TimeStep, float Duration);
+		void time(float t);
+
+	protected:
+		GLBuffer m_Buffer;
+
+		uint32_t m_DataOffset;
+		uint32_t m_TimingOffset;
+	};//UBOVertexAnimationData
+
+}//name space
+
+#endif
@@ -149,6 +149,17 @@ namespace CForge {
 		return Rval;
 	}//scaleMatrix
 
+	Eigen::Matrix4f CForgeMath::modelMatrix(const Eigen::Quaternionf Rot, const Eigen::Vector3f Trans, const Eigen::Vector3f Scale) {
+		Matrix4f Rval = Matrix4f::Identity();
+		Rval.block<3, 3>(0, 0) = Rot.toRotationMatrix() * Scale.asDiagonal();
+		Rval.block<3, 1>(0, 3) = Trans;
+		return Rval;
+	}//modelMatrix
+
+	Eigen::Matrix3f CForgeMath::normalMatrix(const Eigen::Quaternionf Rot, const Eigen::Vector3f Scale) {
+		return Rot.toRotationMatrix() * Scale.cwiseInverse().asDiagonal();
+	}//normalMatrix
+
 	// thanks to: ChatGPT
 	Eigen::Matrix3f CForgeMath::alignVectors(const Eigen::Vector3f Source, const Eigen::Vector3f Target) {
 		const Vector3f a = Source;
@@ -83,6 +83,15 @@ namespace CForge {
 		static Eigen::Matrix4f translationMatrix(Eigen::Vector3f Trans);
 		static Eigen::Matrix4f scaleMatrix(Eigen::Vector3f Scale);
 
+		/**
+		* \brief Builds T*R*S directly from the components.
+		*/
+		static Eigen::Matrix4f modelMatrix(const Eigen::Quaternionf Rot, const Eigen::Vector3f Trans, const Eigen::Vector3f Scale);
+		/**
+		* \brief Inverse transpose of the model matrix computed from rotation and scale (R * S^-1), no general inverse required.
+		*/
+		static Eigen::Matrix3f normalMatrix(const Eigen::Quaternionf Rot, const Eigen::Vector3f Scale);
+
 		static Eigen::Matrix3f alignVectors(const Eigen::Vector3f Source, const Eigen::Vector3f Target);
 
 		static Eigen::Vector3f equirectangularMapping(const Eigen::Vector3f Pos);
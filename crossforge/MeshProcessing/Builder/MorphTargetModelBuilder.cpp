@@ -1,68 +1,106 @@
+#include "../../Core/SThreadPool.h"
 #include "MorphTargetModelBuilder.h"
 
+using namespace Eigen;
+
 namespace CForge {
 
 	MorphTargetModelBuilder::MorphTargetModelBuilder(void): CForgeObject("MorphTargetModelBuilder") {
-
+		m_pThreadPool = nullptr;
 	}//Constructor
 
 	MorphTargetModelBuilder::~MorphTargetModelBuilder(void) {
 		clear();
 	}//Destructor
 
-	void MorphTargetModelBuilder::init(T3DMesh<float>* pBaseMesh) {
+	void MorphTargetModelBuilder::init(T3DMesh<float>* pBaseMesh, const BuildConfig* pConfig) {
 		if (nullptr == pBaseMesh) throw NullpointerExcept("pBaseMesh");
 		if (pBaseMesh->vertexCount() == 0) throw CForgeExcept("Specified mesh contains no vertex data and is therefore unsuitable for morph target building!");
+		if (nullptr != pConfig && pConfig->Threshold < 0.0f) throw CForgeExcept("Threshold must not be negative!");
+		if (nullptr != pConfig && pConfig->Quantization < 0.0f) throw CForgeExcept("Quantization step must not be negative!");
 		clear();
 
-		m_BaseMesh.init(pBaseMesh);
+		m_Config = (nullptr != pConfig) ? (*pConfig) : BuildConfig();
 
+		const uint32_t VertexCount = pBaseMesh->vertexCount();
+		m_BasePositions = Map<const Matrix3Xf>(pBaseMesh->vertex(0).data(), 3, VertexCount);
+		if (pBaseMesh->normalCount() == VertexCount) m_BaseNormals = Map<const Matrix3Xf>(pBaseMesh->normal(0).data(), 3, VertexCount);
+		if (m_Config.Parallel) m_pThreadPool = SThreadPool::instance();
 	}//initialize
 
 	void MorphTargetModelBuilder::clear(void) {
-		m_BaseMesh.clear();
 		for (auto& i : m_MorphTargets) delete i;
-		for (auto& i : m_Targets) delete i;
 		m_MorphTargets.clear();
-		m_Targets.clear();
+		m_BasePositions.resize(3, 0);
+		m_BaseNormals.resize(3, 0);
+		m_Config = BuildConfig();
+		if (nullptr != m_pThreadPool) m_pThreadPool->release();
+		m_pThreadPool = nullptr;
 	}//clear
 
 	void MorphTargetModelBuilder::addTarget(T3DMesh<float>* pTarget, std::string Name) {
 		if (nullptr == pTarget) throw NullpointerExcept("pTarget");
-		if (pTarget->vertexCount() != m_BaseMesh.vertexCount()) throw CForgeExcept("Number of mesh vertices differs from base mesh vertex count. Mesh is unsuited to be a morph target!");
-
-		Target* pNewTarget = new Target();
-		pNewTarget->Name = Name;
-		for (uint32_t i = 0; i < pTarget->vertexCount(); ++i) pNewTarget->Positions.push_back(pTarget->vertex(i));
-		for (uint32_t i = 0; i < pTarget->normalCount(); ++i) pNewTarget->Normals.push_back(pTarget->normal(i));
-		m_Targets.push_back(pNewTarget);
+		if (m_BasePositions.cols() == 0) throw NotInitializedExcept("Morph target builder was not initialized!");
+		if (pTarget->vertexCount() != m_BasePositions.cols()) throw CForgeExcept("Number of mesh vertices differs from base mesh vertex count. Mesh is unsuited to be a morph target!");
+
+		const uint32_t VertexCount = uint32_t(m_BasePositions.cols());
+		const uint32_t BatchSize = 16384;
+		const uint32_t BatchCount = (VertexCount + BatchSize - 1) / BatchSize;
+		const float* pPositions = pTarget->vertex(0).data();
+
+		// batches keep their results apart, concatenating them preserves the vertex order
+		std::vector<std::vector<uint32_t>> BatchIDs(BatchCount);
+		std::vector<std::vector<Vector3f>> BatchOffsets(BatchCount);
+		auto Job = [&](uint32_t Batch) {
+			computeOffsets(m_BasePositions, pPositions, Batch * BatchSize, std::min((Batch + 1) * BatchSize, VertexCount), &BatchIDs[Batch], &BatchOffsets[Batch]);
+		};
+
+		if (nullptr == m_pThreadPool || BatchCount == 1) {
+			for (uint32_t i = 0; i < BatchCount; ++i) Job(i);
+		}
+		else {
+			m_pThreadPool->parallelFor(BatchCount, Job);
+		}
+
+		T3DMesh<float>::MorphTarget* pMT = new T3DMesh<float>::MorphTarget();
+		pMT->ID = int32_t(m_MorphTargets.size());
+		pMT->Name = Name;
+		for (uint32_t i = 0; i < BatchCount; ++i) {
+			pMT->VertexIDs.insert(pMT->VertexIDs.end(), BatchIDs[i].begin(), BatchIDs[i].end());
+			pMT->VertexOffsets.insert(pMT->VertexOffsets.end(), BatchOffsets[i].begin(), BatchOffsets[i].end());
+		}//for[batches]
+
+		// normal offsets of the displaced vertices
+		if (m_BaseNormals.cols() == VertexCount && pTarget->normalCount() == VertexCount) {
+			pMT->NormalOffsets.reserve(pMT->VertexIDs.size());
+			for (auto i : pMT->VertexIDs) pMT->NormalOffsets.push_back(pTarget->normal(i) - m_BaseNormals.col(i));
+		}
+
+		m_MorphTargets.push_back(pMT);
 	}//addTarget
 
-	void MorphTargetModelBuilder::build(void) {
-		for (auto& i : m_MorphTargets) delete i;
-		m_MorphTargets.clear();
-
-		for (auto i : m_Targets) {
-			T3DMesh<float>::MorphTarget* pMT = new T3DMesh<float>::MorphTarget();
-
-			for (uint32_t k = 0; k < m_BaseMesh.vertexCount(); ++k) {
-				Eigen::Vector3f Offset = i->Positions[k] - m_BaseMesh.vertex(k);
-				if (Offset.norm() > 0.01f) {
-					pMT->VertexIDs.push_back(k);
-					pMT->VertexOffsets.push_back(Offset);
-
-					if (m_BaseMesh.normalCount() > k && i->Normals.size() >= k) {
-						Offset = i->Normals[k] - m_BaseMesh.normal(k);
-						pMT->NormalOffsets.push_back(Offset);
-					}
-				}
-			}//for[all vertices (and normals)]
+	void MorphTargetModelBuilder::computeOffsets(const Eigen::Matrix3Xf& Base, const float* pTarget, uint32_t Begin, uint32_t End, std::vector<uint32_t>* pIDs, std::vector<Eigen::Vector3f>* pOffsets) {
+		const uint32_t Count = End - Begin;
+
+		// whole batch at once, column wise operations vectorize
+		Matrix3Xf Offsets = Map<const Matrix3Xf>(&pTarget[size_t(Begin) * 3], 3, Count) - Base.middleCols(Begin, Count);
+		if (m_Config.Quantization > 0.0f) {
+			Offsets = (Offsets.array() / m_Config.Quantization).round() * m_Config.Quantization;
+		}
+		const RowVectorXf SquaredNorms = Offsets.colwise().squaredNorm();
+		const float SquaredThreshold = m_Config.Threshold * m_Config.Threshold;
+
+		for (uint32_t i = 0; i < Count; ++i) {
+			// quantized offsets of zero are never kept
+			if (SquaredNorms[i] <= SquaredThreshold || SquaredNorms[i] == 0.0f) continue;
+			pIDs->push_back(Begin + i);
+			pOffsets->push_back(Offsets.col(i));
+		}//for[vertices of batch]
+	}//computeOffsets
 
-			pMT->ID = m_MorphTargets.size();
-			pMT->Name = i->Name;
-
-			m_MorphTargets.push_back(pMT);
-		}//for[all targets]
+	void MorphTargetModelBuilder::build(void) {
+		// targets are processed when added, only consecutive IDs remain to be ensured
+		for (uint32_t i = 0; i < m_MorphTargets.size(); ++i) m_MorphTargets[i]->ID = int32_t(i);
 	}//build
 
 	void MorphTargetModelBuilder::retrieveMorphTargets(T3DMesh<float>* pMesh) {
@@ -71,4 +109,8 @@ namespace CForge {
 		}//for[all morph targets]
 	}//retrieveMorphTargets
 
-}//name space
\ No newline at end of file
+	uint32_t MorphTargetModelBuilder::targetCount(void)const {
+		return uint32_t(m_MorphTargets.size());
+	}//targetCount
+
+}//name space
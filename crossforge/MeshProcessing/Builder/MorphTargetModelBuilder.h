@@ -22,32 +22,61 @@
 #include "../../AssetIO/T3DMesh.hpp"
 
 namespace CForge {
+	/**
+	* \brief Builds sparse morph targets from meshes in full vertex correspondence with a base mesh.
+	*
+	* Targets are processed as they are added: only the displacements above the threshold are kept, so the target mesh can be discarded (or reused for loading the next target) right after addTarget. Displacements are computed on vertex batches with Eigen's vectorized column operations, batches are distributed over the threads of SThreadPool.
+	*
+	* \todo Do full documentation.
+	*/
 	class CFORGE_API MorphTargetModelBuilder: public CForgeObject {
 	public: 
+		struct BuildConfig {
+			float Threshold;	///< Vertices displaced less than this distance are not part of a target
+			float Quantization; ///< Displacements get rounded to multiples of this step, 0 disables quantization
+			bool Parallel;		///< Use the worker threads
+
+			BuildConfig(void) {
+				Threshold = 0.01f;
+				Quantization = 0.0f;
+				Parallel = true;
+			}
+		};//BuildConfig
+
 		MorphTargetModelBuilder(void);
 		~MorphTargetModelBuilder(void);
 
-		void init(T3DMesh<float>* pBaseMesh);
+		/**
+		* \brief Initialization method.
+		* \param[in] pBaseMesh Mesh the targets are relative to. Only positions and normals get copied.
+		* \param[in] pConfig Build configuration, defaults if nullptr.
+		*/
+		void init(T3DMesh<float>* pBaseMesh, const BuildConfig* pConfig = nullptr);
 		void clear(void);
 
+		/**
+		* \brief Computes the sparse displacements of a target. The target is not referenced afterwards.
+		* \param[in] pTarget Mesh with the same number and order of vertices as the base mesh.
+		* \param[in] Name Name of the morph target.
+		*/
 		void addTarget(T3DMesh<float>* pTarget, std::string Name);
 		void build(void);
 
 		void retrieveMorphTargets(T3DMesh<float>* pMesh);
 
+		uint32_t targetCount(void)const;
+
 	protected:
-		struct Target {
-			std::string Name; ///< Name of the morph target
-			std::vector<Eigen::Vector3f> Positions; ///< Vertex positions
-			std::vector<Eigen::Vector3f> Normals; ///< per vertex Normals
-		};
-
-		T3DMesh<float> m_BaseMesh;
-		std::vector<Target*> m_Targets;
+		void computeOffsets(const Eigen::Matrix3Xf& Base, const float* pTarget, uint32_t Begin, uint32_t End, std::vector<uint32_t>* pIDs, std::vector<Eigen::Vector3f>* pOffsets);
+
+		BuildConfig m_Config;
+		Eigen::Matrix3Xf m_BasePositions;
+		Eigen::Matrix3Xf m_BaseNormals;
 		std::vector<T3DMesh<float>::MorphTarget*> m_MorphTargets; // the final morph targets
+		class SThreadPool* m_pThreadPool;
 
 	};//MorphTargetModelBuilder
 
 }//name space
 
-#endif 
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "../Core/SThreadPool.h"
+#include "CPUMorphTargetBlending.h"
+
+using namespace Eigen;
+
+namespace CForge {
+
+	CPUMorphTargetBlending::CPUMorphTargetBlending(void): CForgeObject("CPUMorphTargetBlending") {
+		m_ChangedBegin = 0;
+		m_ChangedEnd = 0;
+		m_pThreadPool = nullptr;
+	}//Constructor
+
+	CPUMorphTargetBlending::~CPUMorphTargetBlending(void) {
+		clear();
+	}//Destructor
+
+	void CPUMorphTargetBlending::init(const T3DMesh<float>* pMesh) {
+		clear();
+		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
+		if (pMesh->morphTargetCount() == 0) throw CForgeExcept("Mesh has no morph targets!");
+
+		const uint32_t VertexCount = pMesh->vertexCount();
+		const uint32_t MorphTargetCount = pMesh->morphTargetCount();
+		const bool HasNormals = (pMesh->normalCount() == VertexCount);
+
+		m_BasePositions.resize(VertexCount);
+		if (HasNormals) m_BaseNormals.resize(VertexCount);
+		for (uint32_t i = 0; i < VertexCount; ++i) {
+			const Vector3f P = pMesh->vertex(i);
+			m_BasePositions[i] = Vector4f(P.x(), P.y(), P.z(), 1.0f);
+			if (!HasNormals) continue;
+			const Vector3f N = pMesh->normal(i);
+			m_BaseNormals[i] = Vector4f(N.x(), N.y(), N.z(), 0.0f);
+		}//for[vertices]
+
+		// count entries per vertex
+		m_EntryStart.assign(VertexCount + 1, 0);
+		for (uint32_t i = 0; i < MorphTargetCount; ++i) {
+			const T3DMesh<float>::MorphTarget* pMT = pMesh->getMorphTarget(i);
+			for (auto k : pMT->VertexIDs) {
+				if (k >= VertexCount) throw IndexOutOfBoundsExcept("Morph target vertex ID");
+				m_EntryStart[k + 1]++;
+			}
+		}//for[morph targets]
+		for (uint32_t i = 0; i < VertexCount; ++i) m_EntryStart[i + 1] += m_EntryStart[i];
+
+		// group displacements by vertex and remember which vertices each target moves
+		std::vector<uint32_t> Cursor(m_EntryStart.begin(), m_EntryStart.end() - 1);
+		m_Entries.resize(m_EntryStart[VertexCount]);
+		m_TargetRanges.resize(MorphTargetCount);
+		for (uint32_t i = 0; i < MorphTargetCount; ++i) {
+			const T3DMesh<float>::MorphTarget* pMT = pMesh->getMorphTarget(i);
+			const bool NormalOffsets = HasNormals && (pMT->NormalOffsets.size() == pMT->VertexIDs.size());
+			Vector2i Range(VertexCount, 0);
+
+			for (uint32_t k = 0; k < pMT->VertexIDs.size(); ++k) {
+				const uint32_t ID = pMT->VertexIDs[k];
+				const Vector3f PO = pMT->VertexOffsets[k];
+				const Vector3f NO = (NormalOffsets) ? pMT->NormalOffsets[k] : Vector3f::Zero();
+				Entry* pEntry = &m_Entries[Cursor[ID]++];
+				pEntry->PositionOffset = Vector4f(PO.x(), PO.y(), PO.z(), 0.0f);
+				pEntry->NormalOffset = Vector4f(NO.x(), NO.y(), NO.z(), 0.0f);
+				pEntry->MorphTargetID = int32_t(i);
+				Range[0] = std::min(Range[0], int32_t(ID));
+				Range[1] = std::max(Range[1], int32_t(ID + 1));
+			}//for[vertex IDs]
+
+			m_TargetRanges[i] = Range;
+		}//for[morph targets]
+
+		m_Positions = m_BasePositions;
+		m_Normals = m_BaseNormals;
+		m_Weights.assign(MorphTargetCount, 0.0f);
+		m_pThreadPool = SThreadPool::instance();
+	}//initialize
+
+	void CPUMorphTargetBlending::clear(void) {
+		m_BasePositions.clear();
+		m_BaseNormals.clear();
+		m_Positions.clear();
+		m_Normals.clear();
+		m_Entries.clear();
+		m_EntryStart.clear();
+		m_TargetRanges.clear();
+		m_Weights.clear();
+		m_NextWeights.clear();
+		m_ChangedBegin = 0;
+		m_ChangedEnd = 0;
+		if (nullptr != m_pThreadPool) m_pThreadPool->release();
+		m_pThreadPool = nullptr;
+	}//clear
+
+	void CPUMorphTargetBlending::blend(const float* pWeights, uint32_t WeightCount, bool Parallel) {
+		if (nullptr == pWeights && WeightCount > 0) throw NullpointerExcept("pWeights");
+		if (m_Weights.empty()) throw NotInitializedExcept("Morph target blending was not initialized!");
+
+		const uint32_t MorphTargetCount = uint32_t(m_Weights.size());
+		m_NextWeights.assign(MorphTargetCount, 0.0f);
+		std::copy_n(pWeights, std::min(WeightCount, MorphTargetCount), m_NextWeights.begin());
+
+		// only vertices of targets whose weight changed need to be recomputed
+		int32_t Begin = int32_t(m_Positions.size());
+		int32_t End = 0;
+		for (uint32_t i = 0; i < MorphTargetCount; ++i) {
+			if (m_NextWeights[i] == m_Weights[i]) continue;
+			Begin = std::min(Begin, m_TargetRanges[i][0]);
+			End = std::max(End, m_TargetRanges[i][1]);
+		}//for[morph targets]
+		m_Weights.swap(m_NextWeights);
+
+		m_ChangedBegin = 0;
+		m_ChangedEnd = 0;
+		if (Begin >= End) return;
+		m_ChangedBegin = uint32_t(Begin);
+		m_ChangedEnd = uint32_t(End);
+
+		const uint32_t VertexCount = m_ChangedEnd - m_ChangedBegin;
+		const uint32_t BatchSize = 4096;
+
+		if (!Parallel || VertexCount <= BatchSize) {
+			blendRange(m_ChangedBegin, m_ChangedEnd);
+			return;
+		}
+
+		const uint32_t BatchCount = (VertexCount + BatchSize - 1) / BatchSize;
+		m_pThreadPool->parallelFor(BatchCount, [&](uint32_t Batch) {
+			blendRange(m_ChangedBegin + Batch * BatchSize, std::min(m_ChangedBegin + (Batch + 1) * BatchSize, m_ChangedEnd));
+		});
+	}//blend
+
+	void CPUMorphTargetBlending::blendRange(uint32_t Begin, uint32_t End) {
+		const float* pWeights = m_Weights.data();
+
+		if (m_BaseNormals.empty()) {
+			for (uint32_t i = Begin; i < End; ++i) {
+				Vector4f P = m_BasePositions[i];
+				for (uint32_t k = m_EntryStart[i]; k < m_EntryStart[i + 1]; ++k) {
+					P.noalias() += pWeights[m_Entries[k].MorphTargetID] * m_Entries[k].PositionOffset;
+				}
+				m_Positions[i] = P;
+			}//for[vertices]
+			return;
+		}
+
+		for (uint32_t i = Begin; i < End; ++i) {
+			Vector4f P = m_BasePositions[i];
+			Vector4f N = m_BaseNormals[i];
+			for (uint32_t k = m_EntryStart[i]; k < m_EntryStart[i + 1]; ++k) {
+				const Entry& E = m_Entries[k];
+				const float w = pWeights[E.MorphTargetID];
+				P.noalias() += w * E.PositionOffset;
+				N.noalias() += w * E.NormalOffset;
+			}//for[entries of vertex]
+			m_Positions[i] = P;
+			m_Normals[i] = N;
+		}//for[vertices]
+	}//blendRange
+
+	uint32_t CPUMorphTargetBlending::vertexCount(void)const {
+		return uint32_t(m_Positions.size());
+	}//vertexCount
+
+	uint32_t CPUMorphTargetBlending::morphTargetCount(void)const {
+		return uint32_t(m_TargetRanges.size());
+	}//morphTargetCount
+
+	bool CPUMorphTargetBlending::hasNormals(void)const {
+		return !m_Normals.empty();
+	}//hasNormals
+
+	const Eigen::Vector4f* CPUMorphTargetBlending::positions(void)const {
+		return m_Positions.data();
+	}//positions
+
+	const Eigen::Vector4f* CPUMorphTargetBlending::normals(void)const {
+		return (m_Normals.empty()) ? nullptr : m_Normals.data();
+	}//normals
+
+	void CPUMorphTargetBlending::changedRange(uint32_t* pBegin, uint32_t* pEnd)const {
+		if (nullptr == pBegin) throw NullpointerExcept("pBegin");
+		if (nullptr == pEnd) throw NullpointerExcept("pEnd");
+		*pBegin = m_ChangedBegin;
+		*pEnd = m_ChangedEnd;
+	}//changedRange
+
+}//name space
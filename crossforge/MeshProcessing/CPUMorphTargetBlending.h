@@ -0,0 +1,90 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): CPUMorphTargetBlending.h and CPUMorphTargetBlending.cpp          *
+*                                                                           *
+* Content: Blends weighted morph targets into positions and normals on the *
+*          CPU.                                                             *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_CPUMORPHTARGETBLENDING_H__
+#define __CFORGE_CPUMORPHTARGETBLENDING_H__
+
+#include "../Core/CForgeObject.h"
+#include "../AssetIO/T3DMesh.hpp"
+
+namespace CForge {
+	/**
+	* \brief Deforms a mesh by any number of weighted morph targets on the CPU. Used by MorphTargetActor to blend once per frame into a vertex buffer that all render passes draw from.
+	*
+	* Displacements are stored sparse and grouped by vertex, so every vertex gathers its own targets without write conflicts. Positions, normals and displacements are homogeneous 4D vectors, so Eigen vectorizes the accumulation. Only vertices moved by targets whose weight is or was non-zero get recomputed, vertex batches are distributed over the threads of SThreadPool.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API CPUMorphTargetBlending : public CForgeObject {
+	public:
+		CPUMorphTargetBlending(void);
+		~CPUMorphTargetBlending(void);
+
+		void init(const T3DMesh<float>* pMesh);
+		void clear(void);
+
+		/**
+		* \brief Blends the morph targets.
+		* \param[in] pWeights One weight per morph target, e.g. from MorphTargetAnimationController::apply.
+		* \param[in] WeightCount Number of weights. Missing weights count as zero.
+		* \param[in] Parallel Use the worker threads.
+		*/
+		void blend(const float* pWeights, uint32_t WeightCount, bool Parallel = true);
+
+		uint32_t vertexCount(void)const;
+		uint32_t morphTargetCount(void)const;
+		bool hasNormals(void)const;
+
+		const Eigen::Vector4f* positions(void)const; ///< Homogeneous positions (w = 1) of all vertices.
+		const Eigen::Vector4f* normals(void)const; ///< Unnormalized normals (w = 0) of all vertices, nullptr if the mesh has none.
+
+		/**
+		* \brief Vertices changed by the last call to blend, empty range if none changed.
+		* \param[out] pBegin First changed vertex.
+		* \param[out] pEnd One past the last changed vertex.
+		*/
+		void changedRange(uint32_t* pBegin, uint32_t* pEnd)const;
+
+	protected:
+		struct Entry {
+			Eigen::Vector4f PositionOffset;
+			Eigen::Vector4f NormalOffset;
+			int32_t MorphTargetID;
+		};
+
+		void blendRange(uint32_t Begin, uint32_t End);
+
+		std::vector<Eigen::Vector4f> m_BasePositions;
+		std::vector<Eigen::Vector4f> m_BaseNormals;
+		std::vector<Eigen::Vector4f> m_Positions;
+		std::vector<Eigen::Vector4f> m_Normals;
+
+		std::vector<Entry> m_Entries; ///< Displacements grouped by vertex
+		std::vector<uint32_t> m_EntryStart; ///< First entry of each vertex, VertexCount + 1 values
+		std::vector<Eigen::Vector2i> m_TargetRanges; ///< First and one past the last vertex each morph target moves
+
+		std::vector<float> m_Weights; ///< Weights of the last blend
+		std::vector<float> m_NextWeights;
+		uint32_t m_ChangedBegin;
+		uint32_t m_ChangedEnd;
+
+		class SThreadPool* m_pThreadPool;
+	};//CPUMorphTargetBlending
+
+}//name space
+
+#endif
@@ -0,0 +1,127 @@
+#include "../Core/SThreadPool.h"
+#include "../Graphics/Actors/VertexUtility.h"
+#include "CPUSkinning.h"
+
+using namespace Eigen;
+
+namespace CForge {
+
+	CPUSkinning::CPUSkinning(void): CForgeObject("CPUSkinning") {
+		m_MaxBoneIndex = -1;
+		m_pThreadPool = nullptr;
+	}//Constructor
+
+	CPUSkinning::~CPUSkinning(void) {
+		clear();
+	}//Destructor
+
+	void CPUSkinning::init(const T3DMesh<float>* pMesh) {
+		clear();
+		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
+		if (pMesh->boneCount() == 0) throw CForgeExcept("Mesh has no bones!");
+
+		const uint32_t VertexCount = pMesh->vertexCount();
+		const bool HasNormals = (pMesh->normalCount() == VertexCount);
+
+		m_BindPositions.resize(VertexCount);
+		m_BindNormals.resize(VertexCount);
+		for (uint32_t i = 0; i < VertexCount; ++i) {
+			const Vector3f P = pMesh->vertex(i);
+			const Vector3f N = (HasNormals) ? pMesh->normal(i) : Vector3f::Zero();
+			m_BindPositions[i] = Vector4f(P.x(), P.y(), P.z(), 1.0f);
+			m_BindNormals[i] = Vector4f(N.x(), N.y(), N.z(), 0.0f);
+		}//for[vertices]
+
+		VertexUtility::buildSkeletonAssignment(pMesh, &m_BoneIndices, &m_BoneWeights);
+		for (const auto& i : m_BoneIndices) m_MaxBoneIndex = std::max(m_MaxBoneIndex, i.maxCoeff());
+
+		m_Positions = m_BindPositions;
+		m_Normals = m_BindNormals;
+		m_pThreadPool = SThreadPool::instance();
+	}//initialize
+
+	void CPUSkinning::clear(void) {
+		m_BindPositions.clear();
+		m_BindNormals.clear();
+		m_BoneIndices.clear();
+		m_BoneWeights.clear();
+		m_Positions.clear();
+		m_Normals.clear();
+		m_MaxBoneIndex = -1;
+		if (nullptr != m_pThreadPool) m_pThreadPool->release();
+		m_pThreadPool = nullptr;
+	}//clear
+
+	void CPUSkinning::skin(const Eigen::Matrix4f* pSkinningMats, uint32_t MatrixCount, bool Parallel) {
+		if (nullptr == pSkinningMats) throw NullpointerExcept("pSkinningMats");
+		if (int32_t(MatrixCount) <= m_MaxBoneIndex) throw IndexOutOfBoundsExcept("MatrixCount");
+
+		if (nullptr == m_pThreadPool) throw NotInitializedExcept("CPU skinning was not initialized!");
+
+		const uint32_t VertexCount = uint32_t(m_BindPositions.size());
+		const uint32_t BatchSize = 2048;
+
+		if (!Parallel || VertexCount <= BatchSize) {
+			skinRange(pSkinningMats, 0, VertexCount);
+			return;
+		}
+
+		const uint32_t BatchCount = (VertexCount + BatchSize - 1) / BatchSize;
+		m_pThreadPool->parallelFor(BatchCount, [&](uint32_t Batch) {
+			skinRange(pSkinningMats, Batch * BatchSize, std::min((Batch + 1) * BatchSize, VertexCount));
+		});
+	}//skin
+
+	void CPUSkinning::skinRange(const Eigen::Matrix4f* pSkinningMats, uint32_t Begin, uint32_t End) {
+		for (uint32_t i = Begin; i < End; ++i) {
+			const Vector4i& Indices = m_BoneIndices[i];
+			const Vector4f& Weights = m_BoneWeights[i];
+
+			// blend the matrices as the shader does (4x4 operations vectorize column wise)
+			Matrix4f T = Weights[0] * pSkinningMats[Indices[0]];
+			T.noalias() += Weights[1] * pSkinningMats[Indices[1]];
+			T.noalias() += Weights[2] * pSkinningMats[Indices[2]];
+			T.noalias() += Weights[3] * pSkinningMats[Indices[3]];
+
+			m_Positions[i].noalias() = T * m_BindPositions[i];
+			m_Normals[i].noalias() = T * m_BindNormals[i];
+		}//for[vertices]
+	}//skinRange
+
+	uint32_t CPUSkinning::vertexCount(void)const {
+		return uint32_t(m_Positions.size());
+	}//vertexCount
+
+	Eigen::Vector3f CPUSkinning::position(uint32_t Index)const {
+		if (Index >= m_Positions.size()) throw IndexOutOfBoundsExcept("Index");
+		return m_Positions[Index].head<3>();
+	}//position
+
+	Eigen::Vector3f CPUSkinning::normal(uint32_t Index)const {
+		if (Index >= m_Normals.size()) throw IndexOutOfBoundsExcept("Index");
+		const Vector3f N = m_Normals[Index].head<3>();
+		return (N.squaredNorm() > 0.0f) ? Vector3f(N.normalized()) : N;
+	}//normal
+
+	Eigen::AlignedBox3f CPUSkinning::bounds(void)const {
+		AlignedBox3f Rval;
+		for (const auto& i : m_Positions) Rval.extend(Vector3f(i.head<3>()));
+		return Rval;
+	}//bounds
+
+	void CPUSkinning::retrieveSkinnedGeometry(T3DMesh<float>* pMesh)const {
+		if (nullptr == pMesh) throw NullpointerExcept("pMesh");
+		if (pMesh->vertexCount() != m_Positions.size()) throw CForgeExcept("Mesh does not match the skinned mesh!");
+
+		std::vector<Vector3f> Positions(m_Positions.size());
+		for (uint32_t i = 0; i < m_Positions.size(); ++i) Positions[i] = m_Positions[i].head<3>();
+		pMesh->vertices(&Positions);
+
+		if (pMesh->normalCount() == m_Normals.size()) {
+			std::vector<Vector3f> Normals(m_Normals.size());
+			for (uint32_t i = 0; i < m_Normals.size(); ++i) Normals[i] = normal(i);
+			pMesh->normals(&Normals);
+		}
+	}//retrieveSkinnedGeometry
+
+}//name space
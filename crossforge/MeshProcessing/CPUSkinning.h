@@ -0,0 +1,74 @@
+/*****************************************************************************\
+*                                                                           *
+* File(s): CPUSkinning.h and CPUSkinning.cpp                                *
+*                                                                           *
+* Content: Linear blend skinning of a mesh on the CPU.                     *
+*                                                                           *
+*                                                                           *
+* Author(s): Tom Uhlmann                                                    *
+*                                                                           *
+*                                                                           *
+* The file(s) mentioned above are provided as is under the terms of the     *
+* MIT License without any warranty or guaranty to work properly.            *
+* For additional license, copyright and contact/support issues see the      *
+* supplied documentation.                                                   *
+*                                                                           *
+\****************************************************************************/
+#ifndef __CFORGE_CPUSKINNING_H__
+#define __CFORGE_CPUSKINNING_H__
+
+#include "../Core/CForgeObject.h"
+#include "../AssetIO/T3DMesh.hpp"
+
+namespace CForge {
+	/**
+	* \brief Deforms a skinned mesh on the CPU with the same linear blend skinning the shaders use. Meant for picking, exporting posed meshes, and exact bounds, also without an OpenGL context.
+	*
+	* Positions and normals are kept as homogeneous 4D vectors, so Eigen vectorizes blending and transformation. Vertices are distributed over the threads of SThreadPool.
+	*
+	* \todo Do full documentation.
+	*/
+	class CFORGE_API CPUSkinning : public CForgeObject {
+	public:
+		CPUSkinning(void);
+		~CPUSkinning(void);
+
+		void init(const T3DMesh<float>* pMesh);
+		void clear(void);
+
+		/**
+		* \brief Skins all vertices.
+		* \param[in] pSkinningMats Skinning palette, e.g. SkeletalAnimationController::skinningMatrices().
+		* \param[in] MatrixCount Number of matrices in the palette. Has to cover all bone indices of the mesh.
+		* \param[in] Parallel Use the worker threads.
+		*/
+		void skin(const Eigen::Matrix4f* pSkinningMats, uint32_t MatrixCount, bool Parallel = true);
+
+		uint32_t vertexCount(void)const;
+		Eigen::Vector3f position(uint32_t Index)const;
+		Eigen::Vector3f normal(uint32_t Index)const;
+		Eigen::AlignedBox3f bounds(void)const; ///< Exact bounds of the skinned positions.
+
+		/**
+		* \brief Replaces positions and normals of the mesh with the skinned ones. The mesh should be the one skinning was initialized with (or a copy), e.g. to store a posed frame with SAssetIO.
+		*/
+		void retrieveSkinnedGeometry(T3DMesh<float>* pMesh)const;
+
+	protected:
+		void skinRange(const Eigen::Matrix4f* pSkinningMats, uint32_t Begin, uint32_t End);
+
+		std::vector<Eigen::Vector4f> m_BindPositions;
+		std::vector<Eigen::Vector4f> m_BindNormals;
+		std::vector<Eigen::Vector4i> m_BoneIndices;
+		std::vector<Eigen::Vector4f> m_BoneWeights;
+		int32_t m_MaxBoneIndex;
+
+		std::vector<Eigen::Vector4f> m_Positions;
+		std::vector<Eigen::Vector4f> m_Normals;
+
+		class SThreadPool* m_pThreadPool;
+	};//CPUSkinning
+
+}//name space
+
+#endif
@@ -8,17 +8,65 @@ layout(std140) uniform BoneData{
 }Bones;
 #endif
 
+#ifdef SKINNING_PALETTES
+uniform sampler2D SkinningPaletteBuffer;
+
+layout (std140) uniform SkinningPaletteData{
+	// 0 is number of joints per palette, 1 is width of the palette texture
+	ivec4 Data;
+}SkinningPalettes;
+
+mat4 fetchSkinningMatrix(int Palette, int Joint){
+	// three rows of the affine matrix per joint, palettes are stored one after another and wrapped at the texture width
+	int Texel = (Palette * SkinningPalettes.Data[0] + Joint) * 3;
+	vec4 Rows[3];
+	for(int i = 0; i < 3; ++i){
+		Rows[i] = texelFetch(SkinningPaletteBuffer, ivec2((Texel + i) % SkinningPalettes.Data[1], (Texel + i) / SkinningPalettes.Data[1]), 0);
+	}
+	return transpose(mat4(Rows[0], Rows[1], Rows[2], vec4(0.0, 0.0, 0.0, 1.0)));
+}
+#endif
+
+#ifdef VERTEX_ANIMATION
+uniform sampler2D VertexAnimationDataBuffer;
+
+layout (std140) uniform VertexAnimationData{
+	// 0 is playback mode (0 baked vertices, 1 baked skinning matrices)
+	// 1 is number of frames, 2 is number of vertices or joints per frame
+	// 3 is width of the data texture
+	ivec4 Data;
+	// 0 is playback time, 1 is time between two frames, 2 is duration of the clip
+	vec4 Timing;
+}VertexAnimation;
+
+vec4 fetchVertexAnimation(int Texel){
+	// data is stored row by row, wrapped at the texture width
+	return texelFetch(VertexAnimationDataBuffer, ivec2(Texel % VertexAnimation.Data[3], Texel / VertexAnimation.Data[3]), 0);
+}
+
+mat4 fetchBakedSkinningMatrix(int Frame, int Joint){
+	// three rows of the affine matrix per joint
+	int Texel = (Frame * VertexAnimation.Data[2] + Joint) * 3;
+	return transpose(mat4(fetchVertexAnimation(Texel), fetchVertexAnimation(Texel + 1), fetchVertexAnimation(Texel + 2), vec4(0.0, 0.0, 0.0, 1.0)));
+}
+#endif
+
 #ifdef MORPHTARGET_ANIMATION 
-uniform sampler2D MorphTargetDataBuffer;
+uniform sampler2D MorphTargetDataBuffer;	///< Sparse displacements (xyz) and morph target ID (w), grouped by vertex
+uniform highp isampler2D MorphTargetIndexBuffer;	///< First entry and number of entries of each vertex
+uniform sampler2D MorphTargetWeightBuffer;	///< Weight of each morph target
 
 layout(std140) uniform MorphTargetData{
-	// 0 is offset in elements (float) to next morph target
-	// 1 is number of active animations 
+	// 0 is width of the morph target textures
+	// 1 is number of morph targets
 	ivec4 Data; 
-	ivec4 ActivationIDs[3];			///< Morph target IDs (capped at 12)
-	vec4 ActivationStrengths[3];	///< Morph target activation strengths (capped at 12)
 }MorphTargets;
 
+ivec2 morphTargetTexel(int Index){
+	// entries are wrapped at the texture width
+	return ivec2(Index % MorphTargets.Data[0], Index / MorphTargets.Data[0]);
+}
+
 #endif
 
 layout(std140) uniform CameraData{
@@ -38,11 +86,19 @@ layout (location = 3) in vec3 UVW;
 
 
 
-#ifdef SKELETAL_ANIMATION
+#if defined(SKELETAL_ANIMATION) || defined(VERTEX_ANIMATION) || defined(SKINNING_PALETTES)
 layout (location = 4) in ivec4 BoneIndices;
 layout (location = 5) in vec4 BoneWeights;
 #endif
 
+#ifdef INSTANCED_RENDERING
+layout (location = 8) in mat4 InstanceModelMatrix;
+layout (location = 12) in mat3 InstanceNormalMatrix;
+#ifdef VERTEX_ANIMATION
+layout (location = 15) in float InstanceTimeOffset;
+#endif
+#endif
+
 #ifdef VERTEX_COLORS 
 layout (location = 6) in vec3 VertexColor;
 out vec3 Color;
@@ -63,6 +119,52 @@ void main(){
 	vec4 Po = vec4(Position, 1.0);
 	vec4 No = vec4(Normal, 0.0);
 
+	mat4 ModelMat = Model.ModelMatrix;
+	mat3 NormalMat = mat3(Model.NormalMatrix);
+#ifdef INSTANCED_RENDERING
+	ModelMat = ModelMat * InstanceModelMatrix;
+	NormalMat = NormalMat * InstanceNormalMatrix;
+#endif
+
+#ifdef VERTEX_ANIMATION
+	float AnimationTime = VertexAnimation.Timing[0];
+#ifdef INSTANCED_RENDERING
+	AnimationTime += InstanceTimeOffset;
+#endif
+	// clips loop, frames get interpolated linearly
+	float FramePos = (VertexAnimation.Timing[2] > 0.0) ? mod(AnimationTime, VertexAnimation.Timing[2]) / VertexAnimation.Timing[1] : 0.0;
+	int Frame0 = min(int(FramePos), VertexAnimation.Data[1] - 1);
+	int Frame1 = min(Frame0 + 1, VertexAnimation.Data[1] - 1);
+	float s = FramePos - float(Frame0);
+
+	if(VertexAnimation.Data[0] == 0){
+		// position and normal per vertex
+		int Texel0 = (Frame0 * VertexAnimation.Data[2] + gl_VertexID) * 2;
+		int Texel1 = (Frame1 * VertexAnimation.Data[2] + gl_VertexID) * 2;
+		Po = vec4(mix(fetchVertexAnimation(Texel0).xyz, fetchVertexAnimation(Texel1).xyz, s), 1.0);
+		No = vec4(mix(fetchVertexAnimation(Texel0 + 1).xyz, fetchVertexAnimation(Texel1 + 1).xyz, s), 0.0);
+	}
+	else{
+		// skinning matrices per joint
+		mat4 T = mat4(0);
+		for(uint i = 0U; i < 4U; ++i){
+			T += BoneWeights[i] * ((1.0 - s) * fetchBakedSkinningMatrix(Frame0, BoneIndices[i]) + s * fetchBakedSkinningMatrix(Frame1, BoneIndices[i]));
+		}//for[4 weights]
+		Po = T * Po;
+		No = T * No;
+	}
+#endif
+
+#ifdef SKINNING_PALETTES
+	// palette of the instance
+	mat4 T = mat4(0);
+	for(uint i = 0U; i < 4U; ++i){
+		T += BoneWeights[i] * fetchSkinningMatrix(gl_InstanceID, BoneIndices[i]);
+	}//for[4 weights]
+	Po = T * Po;
+	No = T * No;
+#endif
+
 #ifdef SKELETAL_ANIMATION 
 	mat4 T = mat4(0);
 	for(uint i = 0U; i < 4U; ++i){
@@ -74,12 +176,12 @@ void main(){
 
 #ifdef MORPHTARGET_ANIMATION
 	vec3 Displ = vec3(0);
-	for(int i = 0; i < MorphTargets.Data[1]; ++i){
-		// compute Offset to fetch from 
-		int ID = MorphTargets.ActivationIDs[i/3][i%3];
-		int Offset = gl_VertexID;
-		Displ += MorphTargets.ActivationStrengths[i/3][i%3] * texelFetch(MorphTargetDataBuffer, ivec2(Offset, ID), 0).rgb;
-	}//for[active morph targets]
+	// only the morph targets that move this vertex are stored
+	ivec2 Entries = texelFetch(MorphTargetIndexBuffer, morphTargetTexel(gl_VertexID), 0).xy;
+	for(int i = Entries.x; i < Entries.x + Entries.y; ++i){
+		vec4 Entry = texelFetch(MorphTargetDataBuffer, morphTargetTexel(i), 0);
+		Displ += texelFetch(MorphTargetWeightBuffer, morphTargetTexel(int(Entry.w)), 0).r * Entry.xyz;
+	}//for[morph targets of vertex]
 
 	Po += vec4(Displ, 0.0);
 #endif
@@ -88,18 +190,18 @@ void main(){
 	Color = VertexColor;
 #endif
 
-	N = Model.NormalMatrix * No; // normalization in fragment shader
+	N = NormalMat * No.xyz; // normalization in fragment shader
 
 #ifdef NORMAL_MAPPING 
-	vec3 Tan = normalize((Model.NormalMatrix * vec4(Tangent, 0.0)));
+	vec3 Tan = normalize(NormalMat * Tangent);
 	vec3 BTan = cross(N, Tan);
 	TBN = mat3(Tan, BTan, N);
 #endif
 
 	
-	Pos = (Model.ModelMatrix * Po).xyz;
+	Pos = (ModelMat * Po).xyz;
 	UV = UVW.xy;
 	
-	gl_Position = Camera.ProjectionMatrix * Camera.ViewMatrix * Model.ModelMatrix * Po;
+	gl_Position = Camera.ProjectionMatrix * Camera.ViewMatrix * ModelMat * Po;
 	
 }//main
\ No newline at end of file
@@ -8,11 +8,60 @@ layout (std140) uniform BoneData{
 }Bones;
 #endif
 
+#ifdef SKINNING_PALETTES
+uniform sampler2D SkinningPaletteBuffer;
+
+layout (std140) uniform SkinningPaletteData{
+	// 0 is number of joints per palette, 1 is width of the palette texture
+	ivec4 Data;
+}SkinningPalettes;
+
+mat4 fetchSkinningMatrix(int Palette, int Joint){
+	// three rows of the affine matrix per joint, palettes are stored one after another and wrapped at the texture width
+	int Texel = (Palette * SkinningPalettes.Data[0] + Joint) * 3;
+	vec4 Rows[3];
+	for(int i = 0; i < 3; ++i){
+		Rows[i] = texelFetch(SkinningPaletteBuffer, ivec2((Texel + i) % SkinningPalettes.Data[1], (Texel + i) / SkinningPalettes.Data[1]), 0);
+	}
+	return transpose(mat4(Rows[0], Rows[1], Rows[2], vec4(0.0, 0.0, 0.0, 1.0)));
+}
+#endif
+
+#ifdef VERTEX_ANIMATION
+uniform sampler2D VertexAnimationDataBuffer;
+
+layout (std140) uniform VertexAnimationData{
+	// 0 is playback mode (0 baked vertices, 1 baked skinning matrices)
+	// 1 is number of frames, 2 is number of vertices or joints per frame
+	// 3 is width of the data texture
+	ivec4 Data;
+	// 0 is playback time, 1 is time between two frames, 2 is duration of the clip
+	vec4 Timing;
+}VertexAnimation;
+
+vec4 fetchVertexAnimation(int Texel){
+	// data is stored row by row, wrapped at the texture width
+	return texelFetch(VertexAnimationDataBuffer, ivec2(Texel % VertexAnimation.Data[3], Texel / VertexAnimation.Data[3]), 0);
+}
+
+mat4 fetchBakedSkinningMatrix(int Frame, int Joint){
+	// three rows of the affine matrix per joint
+	int Texel = (Frame * VertexAnimation.Data[2] + Joint) * 3;
+	return transpose(mat4(fetchVertexAnimation(Texel), fetchVertexAnimation(Texel + 1), fetchVertexAnimation(Texel + 2), vec4(0.0, 0.0, 0.0, 1.0)));
+}
+#endif
+
 layout (location = 0) in vec3 Position;
-#ifdef SKELETAL_ANIMATION
+#if defined(SKELETAL_ANIMATION) || defined(VERTEX_ANIMATION) || defined(SKINNING_PALETTES)
 layout (location = 4) in ivec4 BoneIndices;
 layout (location = 5) in vec4 BoneWeights;
 #endif
+#ifdef INSTANCED_RENDERING
+layout (location = 8) in mat4 InstanceModelMatrix;
+#ifdef VERTEX_ANIMATION
+layout (location = 15) in float InstanceTimeOffset;
+#endif
+#endif
 
 uniform uint ActiveLightID;
 
@@ -33,6 +82,47 @@ layout(std140) uniform ModelData{
 void main(){
 	vec4 Po = vec4(Position, 1.0);
 
+	mat4 ModelMat = ModelMatrix;
+#ifdef INSTANCED_RENDERING
+	ModelMat = ModelMat * InstanceModelMatrix;
+#endif
+
+#ifdef VERTEX_ANIMATION
+	float AnimationTime = VertexAnimation.Timing[0];
+#ifdef INSTANCED_RENDERING
+	AnimationTime += InstanceTimeOffset;
+#endif
+	// clips loop, frames get interpolated linearly
+	float FramePos = (VertexAnimation.Timing[2] > 0.0) ? mod(AnimationTime, VertexAnimation.Timing[2]) / VertexAnimation.Timing[1] : 0.0;
+	int Frame0 = min(int(FramePos), VertexAnimation.Data[1] - 1);
+	int Frame1 = min(Frame0 + 1, VertexAnimation.Data[1] - 1);
+	float s = FramePos - float(Frame0);
+
+	if(VertexAnimation.Data[0] == 0){
+		// position and normal per vertex
+		int Texel0 = (Frame0 * VertexAnimation.Data[2] + gl_VertexID) * 2;
+		int Texel1 = (Frame1 * VertexAnimation.Data[2] + gl_VertexID) * 2;
+		Po = vec4(mix(fetchVertexAnimation(Texel0).xyz, fetchVertexAnimation(Texel1).xyz, s), 1.0);
+	}
+	else{
+		// skinning matrices per joint
+		mat4 T = mat4(0);
+		for(uint i = 0U; i < 4U; ++i){
+			T += BoneWeights[i] * ((1.0 - s) * fetchBakedSkinningMatrix(Frame0, BoneIndices[i]) + s * fetchBakedSkinningMatrix(Frame1, BoneIndices[i]));
+		}//for[4 weights]
+		Po = T * Po;
+	}
+#endif
+
+#ifdef SKINNING_PALETTES
+	// palette of the instance
+	mat4 T = mat4(0);
+	for(uint i = 0U; i < 4U; ++i){
+		T += BoneWeights[i] * fetchSkinningMatrix(gl_InstanceID, BoneIndices[i]);
+	}//for[4 weights]
+	Po = T * Po;
+#endif
+
 #ifdef SKELETAL_ANIMATION 
 	mat4 T = mat4(0);
 	for(uint i = 0U; i < 4U; ++i){
@@ -42,5 +132,5 @@ void main(){
 	Po = T * Po;
 #endif 
 
-	gl_Position = DirLights.LightSpaceMatrices[ActiveLightID] * ModelMatrix * Po;
+	gl_Position = DirLights.LightSpaceMatrices[ActiveLightID] * ModelMat * Po;
 }//main 